@@ -0,0 +1,483 @@
+#include <benchmark/benchmark.h>
+
+#include <sso/algorithm.hpp>
+#include <sso/arena.hpp>
+#include <sso/case_insensitive.hpp>
+#include <sso/format.hpp>
+#include <sso/hash.hpp>
+#include <sso/interned_string.hpp>
+#include <sso/string.hpp>
+#include <sso/string_builder.hpp>
+#include <sso/string_table.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+// Sizes around small buffer boundary (23 chars) and few long ones
+void
+sizes(benchmark::internal::Benchmark* b)
+{
+    for (long const size : { 0, 8, 15, 22, 23, 24, 32, 64, 256, 4096 }) b->Arg(size);
+}
+
+std::string
+make_source(std::size_t size, unsigned seed = 0)
+{
+    std::mt19937 gen{ seed };
+    std::uniform_int_distribution<int> dist{ 'a', 'z' };
+
+    std::string result(size, '\0');
+    std::ranges::generate(result, [&] { return static_cast<char>(dist(gen)); });
+
+    return result;
+}
+
+template <typename String>
+std::vector<String>
+make_strings(std::size_t count, std::size_t max_size)
+{
+    std::mt19937 gen{ 42 };
+    std::uniform_int_distribution<std::size_t> size_dist{ 0, max_size };
+
+    std::vector<String> result;
+    result.reserve(count);
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        auto const source{ make_source(size_dist(gen), static_cast<unsigned>(i)) };
+        result.emplace_back(std::string_view{ source });
+    }
+
+    return result;
+}
+
+template <typename String>
+void
+construct(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    std::string_view const sv{ source };
+
+    for (auto _ : state)
+    {
+        String s{ sv };
+        benchmark::DoNotOptimize(s);
+    }
+}
+
+// Same as `construct`, but memory is taken from arena, which is released in bulk
+void
+arena_construct(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    std::string_view const sv{ source };
+
+    sso::arena arena{ 1 << 20 };
+    std::size_t count{ 0 };
+    for (auto _ : state)
+    {
+        sso::arena_string s{ arena };
+        s.append(sv);
+        benchmark::DoNotOptimize(s);
+
+        if (++count % 1024 == 0) arena.release();
+    }
+}
+
+template <typename String>
+void
+copy(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String const s{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        String copy{ s };
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+template <typename String>
+void
+move(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String s{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        String moved{ std::move(s) };
+        benchmark::DoNotOptimize(moved);
+        s = std::move(moved);
+    }
+}
+
+template <typename String>
+void
+push_back(benchmark::State& state)
+{
+    auto const count{ static_cast<std::size_t>(state.range(0)) };
+
+    for (auto _ : state)
+    {
+        String s;
+        for (std::size_t i{ 0 }; i < count; ++i) s.push_back('x');
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+template <typename String>
+void
+append(benchmark::State& state)
+{
+    auto const count{ static_cast<std::size_t>(state.range(0)) };
+    std::string_view const chunk{ "0123456789" };
+
+    for (auto _ : state)
+    {
+        String s;
+        for (std::size_t i{ 0 }; i < count; ++i) s.append(chunk);
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * count * chunk.size()));
+}
+
+// Same appends into chunks, which are concatenated once, see append<String>
+void
+builder_append(benchmark::State& state)
+{
+    auto const count{ static_cast<std::size_t>(state.range(0)) };
+    std::string_view const chunk{ "0123456789" };
+
+    for (auto _ : state)
+    {
+        sso::string_builder builder;
+        for (std::size_t i{ 0 }; i < count; ++i) builder.append(chunk);
+        benchmark::DoNotOptimize(builder.str());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * count * chunk.size()));
+}
+
+template <typename String>
+void
+replace(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String s{ std::string_view{ source } };
+    std::string_view const grow{ "abcd" };
+
+    // Sources of 0 and 1 characters have less than 2 characters after the middle
+    auto const pos{ s.size() / 2 };
+    auto const shrink{ std::string_view{ "ab" }.substr(0, s.size() - pos) };
+
+    for (auto _ : state)
+    {
+        s.replace(pos, shrink.size(), grow);
+        s.replace(pos, grow.size(), shrink);
+        benchmark::DoNotOptimize(s);
+    }
+}
+
+template <typename String>
+void
+compare(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String const l{ std::string_view{ source } };
+    String const r{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(l == r);
+        benchmark::DoNotOptimize(l < r);
+    }
+}
+
+template <typename String>
+void
+hash(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String const s{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<String>{}(s));
+    }
+}
+
+void
+fast_hash(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    sso::string const s{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sso::fast_hash{}(s));
+    }
+}
+
+// Equality and hash of interned strings, compare with `compare` and `hash`
+void
+interned(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    sso::arena_intern_pool pool;
+    auto const l{ pool.intern(source) };
+    auto const r{ pool.intern(source) };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(l == r);
+        benchmark::DoNotOptimize(std::hash<sso::interned_string>{}(l));
+    }
+}
+
+// Character class search of tokenizer, source has no delimiters, so whole string is scanned
+template <typename String>
+void
+find_first_of(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String const s{ std::string_view{ source } };
+    std::string_view const delimiters{ " \t\n,;=()" };
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(s.find_first_of(delimiters));
+        benchmark::DoNotOptimize(s.find_last_of(delimiters));
+    }
+}
+
+// `std::string` is converted by `std::transform` + `std::tolower`, as it would be without `to_lower()`
+template <typename String>
+void
+to_lower(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    String s{ std::string_view{ source } };
+
+    for (auto _ : state)
+    {
+        if constexpr (std::is_same_v<String, std::string>)
+        {
+            std::ranges::transform(s, s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        } else
+        {
+            s.to_lower();
+        }
+        benchmark::DoNotOptimize(s);
+    }
+}
+
+// Equal strings in different case, `std::string` is compared by `std::ranges::equal` + `std::tolower`
+template <typename String>
+void
+iequals(benchmark::State& state)
+{
+    auto const source{ make_source(static_cast<std::size_t>(state.range(0))) };
+    auto upper{ source };
+    std::ranges::transform(upper, upper.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    String const l{ std::string_view{ source } };
+    String const r{ std::string_view{ upper } };
+
+    for (auto _ : state)
+    {
+        if constexpr (std::is_same_v<String, std::string>)
+        {
+            benchmark::DoNotOptimize(std::ranges::equal(l, r, [](unsigned char a, unsigned char b)
+                                                        { return std::tolower(a) == std::tolower(b); }));
+        } else
+        {
+            benchmark::DoNotOptimize(sso::iequals(l, r));
+        }
+    }
+}
+
+// Formats message of given width, reusing the same string
+template <typename String>
+void
+format(benchmark::State& state)
+{
+    auto const width{ static_cast<std::size_t>(state.range(0)) };
+    String message;
+
+    for (auto _ : state)
+    {
+        message.clear();
+        if constexpr (std::is_same_v<String, std::string>)
+        {
+            std::format_to(std::back_inserter(message), "{:>{}}", 42, width);
+        } else
+        {
+            sso::format_to(message, "{:>{}}", 42, width);
+        }
+        benchmark::DoNotOptimize(message.data());
+    }
+}
+
+// Moves strings between two buffers, like growing container does
+template <typename String>
+void
+relocate(benchmark::State& state)
+{
+    auto strings{ make_strings<String>(1'000, static_cast<std::size_t>(state.range(0))) };
+    std::allocator<String> allocator;
+    auto* from{ allocator.allocate(strings.size()) };
+    auto* to{ allocator.allocate(strings.size()) };
+    std::ranges::uninitialized_move(strings, std::ranges::subrange(from, from + strings.size()));
+
+    for (auto _ : state)
+    {
+        sso::uninitialized_relocate(from, from + strings.size(), to);
+        std::swap(from, to);
+        benchmark::DoNotOptimize(from);
+    }
+
+    std::destroy(from, from + strings.size());
+    allocator.deallocate(from, strings.size());
+    allocator.deallocate(to, strings.size());
+}
+
+template <typename String>
+void
+sort(benchmark::State& state)
+{
+    auto const strings{ make_strings<String>(10'000, static_cast<std::size_t>(state.range(0))) };
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto copy{ strings };
+        state.ResumeTiming();
+
+        std::ranges::sort(copy);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+// Same strings packed into single buffer, see sort<String>
+void
+table_sort(benchmark::State& state)
+{
+    sso::string_table const strings{ make_strings<std::string>(10'000, static_cast<std::size_t>(state.range(0))) };
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto copy{ strings };
+        state.ResumeTiming();
+
+        copy.sort();
+        benchmark::DoNotOptimize(copy.c_str({ 0 }));
+    }
+}
+
+// Hand-rolled tokenizer, each token is copied by `substr`, see split_view
+template <typename String>
+void
+tokenize(benchmark::State& state)
+{
+    auto const tokens{ make_strings<std::string>(1'000, static_cast<std::size_t>(state.range(0))) };
+    String const source{ std::string_view{ sso::join(tokens, ",") } };
+
+    for (auto _ : state)
+    {
+        std::size_t total{ 0 };
+        for (std::size_t pos{ 0 };;)
+        {
+            auto const end{ source.find(',', pos) };
+            total += source.substr(pos, end - pos).size();
+            if (end == String::npos) break;
+            pos = end + 1;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * tokens.size()));
+}
+
+void
+split_view(benchmark::State& state)
+{
+    auto const tokens{ make_strings<std::string>(1'000, static_cast<std::size_t>(state.range(0))) };
+    auto const source{ sso::join(tokens, ",") };
+
+    for (auto _ : state)
+    {
+        std::size_t total{ 0 };
+        for (auto const token : sso::split(source, ',')) total += token.size();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * tokens.size()));
+}
+
+// Binary search of existing keys in sorted dictionary
+template <typename String>
+void
+lookup(benchmark::State& state)
+{
+    auto dictionary{ make_strings<String>(10'000, static_cast<std::size_t>(state.range(0))) };
+    std::ranges::sort(dictionary);
+
+    auto queries{ dictionary };
+    std::ranges::shuffle(queries, std::mt19937{ 7 });
+
+    for (auto _ : state)
+    {
+        std::size_t found{ 0 };
+        for (auto const& query : queries) found += std::ranges::binary_search(dictionary, query);
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+}
+
+// Trades object size for inline storage of typical identifiers
+using small_string = sso::small_string<63>;
+
+#define SSO_BENCHMARK(name)                                                                        \
+    BENCHMARK_TEMPLATE(name, std::string)->Apply(sizes);                                           \
+    BENCHMARK_TEMPLATE(name, sso::string)->Apply(sizes);                                           \
+    BENCHMARK_TEMPLATE(name, small_string)->Apply(sizes)
+
+SSO_BENCHMARK(construct);
+BENCHMARK(arena_construct)->Apply(sizes);
+SSO_BENCHMARK(copy);
+BENCHMARK_TEMPLATE(copy, sso::shared_string)->Apply(sizes);
+SSO_BENCHMARK(move);
+SSO_BENCHMARK(push_back);
+SSO_BENCHMARK(append);
+BENCHMARK(builder_append)->Apply(sizes);
+SSO_BENCHMARK(replace);
+SSO_BENCHMARK(compare);
+SSO_BENCHMARK(hash);
+BENCHMARK(fast_hash)->Apply(sizes);
+BENCHMARK(interned)->Apply(sizes);
+SSO_BENCHMARK(find_first_of);
+SSO_BENCHMARK(to_lower);
+SSO_BENCHMARK(iequals);
+SSO_BENCHMARK(format);
+SSO_BENCHMARK(relocate);
+SSO_BENCHMARK(sort);
+BENCHMARK(table_sort)->Apply(sizes);
+SSO_BENCHMARK(lookup);
+SSO_BENCHMARK(tokenize);
+BENCHMARK(split_view)->Apply(sizes);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <sso/detail/search.hpp>
+#include <sso/detail/simd.hpp>
+#include <sso/string.hpp>
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+//! Lazy splitting of strings into `string_view`s and joining of strings with single allocation.
+//! Delimiters of byte strings are searched by the same SIMD kernels as `basic_string::find*`.
+namespace sso
+{
+
+namespace detail::split
+{
+
+//! @return index of the first occurrence of `needle` at or after `pos`, or `npos`
+template <typename Char>
+[[nodiscard]] constexpr std::size_t
+find(std::basic_string_view<Char> source, std::basic_string_view<Char> needle, std::size_t pos) noexcept
+{
+    if constexpr (byte_char<Char>)
+    {
+        if (!std::is_constant_evaluated() && pos <= source.size())
+        {
+            auto const found{ search::find(bytes(source.data()) + pos, source.size() - pos, bytes(needle.data()),
+                                           needle.size()) };
+
+            return found == search::npos ? search::npos : pos + found;
+        }
+    }
+
+    return source.find(needle, pos);
+}
+
+//! @return index of the first character of `set` at or after `pos`, or `npos`
+template <typename Char>
+[[nodiscard]] constexpr std::size_t
+find_of(std::basic_string_view<Char> source, std::basic_string_view<Char> set, std::size_t pos) noexcept
+{
+    if constexpr (byte_char<Char>)
+    {
+        if (!std::is_constant_evaluated() && pos <= source.size())
+        {
+            auto const found{ search::find_of<false, false>(bytes(source.data()) + pos, source.size() - pos,
+                                                            bytes(set.data()), set.size()) };
+
+            return found == search::npos ? search::npos : pos + found;
+        }
+    }
+
+    return source.find_first_of(set, pos);
+}
+
+//! Delimiter is `find(source, pos)`, which returns position and size of the next delimiter
+//! at or after `pos` (`npos` if there are no more), see `basic_split_view`
+template <typename Char>
+struct by_string
+{
+    std::basic_string_view<Char> delimiter;
+
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t>
+    find(std::basic_string_view<Char> source, std::size_t pos) const noexcept
+    {
+        return { split::find(source, delimiter, pos), delimiter.size() };
+    }
+};
+
+template <typename Char>
+struct by_char
+{
+    Char delimiter;
+
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t>
+    find(std::basic_string_view<Char> source, std::size_t pos) const noexcept
+    {
+        return { split::find(source, std::basic_string_view<Char>{ &delimiter, 1 }, pos), 1 };
+    }
+};
+
+template <typename Char>
+struct by_any
+{
+    std::basic_string_view<Char> set;
+
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t>
+    find(std::basic_string_view<Char> source, std::size_t pos) const noexcept
+    {
+        return { find_of(source, set, pos), 1 };
+    }
+};
+
+//! "\n" and "\r\n" end lines, text after the last one (if any) is the last line
+template <typename Char>
+struct by_line
+{
+    //! Text ending with line break has no empty line after it
+    static constexpr bool skip_trailing_empty{ true };
+
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t>
+    find(std::basic_string_view<Char> source, std::size_t pos) const noexcept
+    {
+        Char const new_line{ '\n' };
+        auto const found{ split::find(source, std::basic_string_view<Char>{ &new_line, 1 }, pos) };
+        if (found != search::npos && found > pos && source[found - 1] == Char{ '\r' }) return { found - 1, 2 };
+
+        return { found, 1 };
+    }
+};
+
+template <typename Delimiter>
+concept skips_trailing_empty = Delimiter::skip_trailing_empty;
+
+} // namespace detail::split
+
+//! View of parts of `source` between delimiters, which yields `string_view`s into `source`.
+//! `n` delimiters give `n + 1` parts (some of them are empty), e.g. "a,,b" is split by ',' into "a", "", "b".
+//! Nothing is allocated or copied, `source` must outlive the view.
+template <typename Char, typename Delimiter>
+struct basic_split_view : std::ranges::view_interface<basic_split_view<Char, Delimiter>>
+{
+    using string_view = std::basic_string_view<Char>;
+
+    struct iterator;
+
+    constexpr basic_split_view() = default;
+
+    constexpr basic_split_view(string_view source, Delimiter delimiter) noexcept
+        : source_{ source }
+        , delimiter_{ std::move(delimiter) }
+    {
+    }
+
+    [[nodiscard]] constexpr iterator
+    begin() const noexcept
+    {
+        return { this, 0 };
+    }
+
+    [[nodiscard]] constexpr std::default_sentinel_t
+    end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    //! Whole source
+    [[nodiscard]] constexpr string_view
+    base() const noexcept
+    {
+        return source_;
+    }
+
+private:
+    string_view source_;
+    Delimiter delimiter_;
+};
+
+template <typename Char, typename Delimiter>
+struct basic_split_view<Char, Delimiter>::iterator
+{
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = string_view;
+    using difference_type = std::ptrdiff_t;
+    using reference = string_view;
+
+    constexpr iterator() = default;
+
+    //! Finds part, which starts at `pos`
+    constexpr iterator(basic_split_view const* view, std::size_t pos) noexcept
+        : view_{ view }
+    {
+        start(pos);
+    }
+
+    [[nodiscard]] constexpr string_view
+    operator*() const noexcept
+    {
+        return view_->source_.substr(pos_, size_);
+    }
+
+    constexpr iterator&
+    operator++() noexcept
+    {
+        start(next_);
+        return *this;
+    }
+
+    constexpr iterator
+    operator++(int) noexcept
+    {
+        auto const result{ *this };
+        ++*this;
+        return result;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator==(iterator const& l, iterator const& r) noexcept
+    {
+        return l.pos_ == r.pos_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator==(iterator const& it, std::default_sentinel_t) noexcept
+    {
+        return it.pos_ == npos;
+    }
+
+private:
+    static constexpr std::size_t npos{ string_view::npos };
+
+    //! `npos` is the end
+    constexpr void
+    start(std::size_t pos) noexcept
+    {
+        pos_ = pos;
+        if (pos == npos) return;
+
+        auto const source{ view_->source_ };
+        if constexpr (detail::split::skips_trailing_empty<Delimiter>)
+        {
+            if (pos == source.size())
+            {
+                pos_ = npos;
+                return;
+            }
+        }
+
+        auto const [found, size]{ view_->delimiter_.find(source, pos) };
+        size_ = (found == npos ? source.size() : found) - pos;
+        next_ = found == npos ? npos : found + size;
+    }
+
+    basic_split_view const* view_{ nullptr };
+    //! Current part, `pos_` is `npos` at the end
+    std::size_t pos_{ npos };
+    std::size_t size_{ 0 };
+    //! Start of the next part, `npos` if current one is the last
+    std::size_t next_{ npos };
+};
+
+//! String, which is still alive after the call, so views into it don't dangle:
+//! lvalue `basic_string`, `std::basic_string` or literal, or `string_view`
+template <typename Source>
+concept borrowed_text = std::ranges::contiguous_range<Source> && std::ranges::borrowed_range<Source>
+                     && std::convertible_to<Source, std::basic_string_view<std::ranges::range_value_t<Source>>>;
+
+template <borrowed_text Source>
+using text_char_t = std::ranges::range_value_t<Source>;
+
+//! @return parts of `source` separated by `delimiter`, see `basic_split_view`
+//! @pre `!delimiter.empty()`
+template <borrowed_text Source>
+[[nodiscard]] constexpr basic_split_view<text_char_t<Source>, detail::split::by_string<text_char_t<Source>>>
+split(Source&& source, std::basic_string_view<text_char_t<Source>> delimiter) noexcept
+{
+    assert(!delimiter.empty());
+
+    return { std::basic_string_view<text_char_t<Source>>(source), { delimiter } };
+}
+
+template <borrowed_text Source>
+[[nodiscard]] constexpr basic_split_view<text_char_t<Source>, detail::split::by_char<text_char_t<Source>>>
+split(Source&& source, text_char_t<Source> delimiter) noexcept
+{
+    return { std::basic_string_view<text_char_t<Source>>(source), { delimiter } };
+}
+
+//! @return parts of `source` separated by any character of `set`, e.g. " \t" for words
+template <borrowed_text Source>
+[[nodiscard]] constexpr basic_split_view<text_char_t<Source>, detail::split::by_any<text_char_t<Source>>>
+split_any(Source&& source, std::basic_string_view<text_char_t<Source>> set) noexcept
+{
+    return { std::basic_string_view<text_char_t<Source>>(source), { set } };
+}
+
+//! @return lines of `source` without line breaks ("\n" or "\r\n"), empty `source` has no lines
+template <borrowed_text Source>
+[[nodiscard]] constexpr basic_split_view<text_char_t<Source>, detail::split::by_line<text_char_t<Source>>>
+lines(Source&& source) noexcept
+{
+    return { std::basic_string_view<text_char_t<Source>>(source), {} };
+}
+
+//! Concatenates `strings` with `separator` between them. Total size is computed first,
+//! so result is allocated once with exact capacity
+//! @tparam String type of result, e.g. `pmr::string`
+template <typename String = string, std::ranges::forward_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, typename String::string_view>
+[[nodiscard]] String
+join(Range&& strings, typename String::string_view separator,
+     typename String::allocator_type const& allocator = typename String::allocator_type())
+{
+    using string_view = String::string_view;
+
+    typename String::size_type size{ 0 };
+    typename String::size_type count{ 0 };
+    for (string_view str : strings)
+    {
+        size += str.size();
+        ++count;
+    }
+    if (count > 1) size += separator.size() * (count - 1);
+
+    String result{ allocator };
+    result.reserve(size);
+    auto first{ true };
+    for (string_view str : strings)
+    {
+        if (!first) result.append(separator);
+        result.append(str);
+        first = false;
+    }
+
+    return result;
+}
+
+} // namespace sso
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace sso
+{
+
+//! Bump-pointer arena. Allocation moves pointer inside current block,
+//! memory is never freed separately, but all at once in `release()` or destructor.
+//! Not thread-safe.
+struct arena
+{
+    static constexpr std::size_t default_block_size{ 4096 };
+
+    //! @param block_size size of blocks requested from `operator new`,
+    //!        larger allocations get block of their own
+    explicit arena(std::size_t block_size = default_block_size) noexcept
+        : block_size_{ block_size }
+    {
+    }
+
+    arena(arena const&) = delete;
+    arena&
+    operator=(arena const&) = delete;
+
+    ~arena()
+    {
+        release();
+    }
+
+    //! Complexity: O(1), only moves pointer unless current block is exhausted
+    //! @pre `alignment` is power of two
+    [[nodiscard]] void*
+    allocate(std::size_t bytes, std::size_t alignment)
+    {
+        auto const padding{ (std::uintptr_t{} - reinterpret_cast<std::uintptr_t>(current_)) & (alignment - 1) };
+        if (padding + bytes <= static_cast<std::size_t>(end_ - current_)) [[likely]]
+        {
+            auto* const result{ current_ + padding };
+            current_ = result + bytes;
+
+            return result;
+        }
+
+        return allocate_block(bytes, alignment);
+    }
+
+    //! Frees all memory at once
+    //! @pre nothing allocated from `*this` is used afterwards
+    void
+    release() noexcept
+    {
+        while (blocks_ != nullptr)
+        {
+            auto* const next{ blocks_->next };
+            ::operator delete(blocks_, blocks_->size);
+            blocks_ = next;
+        }
+        current_ = nullptr;
+        end_ = nullptr;
+    }
+
+    //! @return total size of blocks requested from `operator new`
+    [[nodiscard]] std::size_t
+    capacity() const noexcept
+    {
+        std::size_t result{ 0 };
+        for (auto const* block{ blocks_ }; block != nullptr; block = block->next) result += block->size;
+
+        return result;
+    }
+
+private:
+    //! Placed at the beginning of each block
+    struct block
+    {
+        block* next;
+        std::size_t size;
+    };
+
+    //! Starts new block, the rest of current one is abandoned
+    [[nodiscard]] void*
+    allocate_block(std::size_t bytes, std::size_t alignment)
+    {
+        auto const size{ std::max(block_size_, sizeof(block) + alignment + bytes) };
+        blocks_ = std::construct_at(static_cast<block*>(::operator new(size)), block{ blocks_, size });
+        current_ = reinterpret_cast<std::byte*>(blocks_ + 1);
+        end_ = reinterpret_cast<std::byte*>(blocks_) + size;
+
+        return allocate(bytes, alignment);
+    }
+
+    std::byte* current_{ nullptr };
+    std::byte* end_{ nullptr };
+    block* blocks_{ nullptr };
+    std::size_t block_size_;
+};
+
+//! Allocates from `arena`, `deallocate` does nothing.
+//! Like `std::pmr::polymorphic_allocator` it isn't propagated, so containers keep their arena.
+template <typename T>
+struct arena_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+    //! Memory is released by `arena`, so strings using this allocator are trivially destructible
+    using is_monotonic = std::true_type;
+
+    constexpr arena_allocator(arena& arena) noexcept
+        : arena_{ &arena }
+    {
+    }
+
+    template <typename U>
+    constexpr arena_allocator(arena_allocator<U> const& other) noexcept
+        : arena_{ other.resource() }
+    {
+    }
+
+    [[nodiscard]] T*
+    allocate(std::size_t count)
+    {
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    constexpr void
+    deallocate(T* /* data */, std::size_t /* count */) noexcept
+    {
+    }
+
+    [[nodiscard]] constexpr arena*
+    resource() const noexcept
+    {
+        return arena_;
+    }
+
+    template <typename U>
+    [[nodiscard]] friend constexpr bool
+    operator==(arena_allocator const& l, arena_allocator<U> const& r) noexcept
+    {
+        return l.resource() == r.resource();
+    }
+
+private:
+    arena* arena_;
+};
+
+template <typename Char>
+using basic_arena_string = basic_string<Char, arena_allocator<Char>>;
+
+//! Request-scoped string: allocation is a pointer bump, destruction is no-op
+using arena_string = basic_arena_string<char>;
+
+} // namespace sso
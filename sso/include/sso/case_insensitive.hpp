@@ -0,0 +1,214 @@
+#pragma once
+
+#include <sso/detail/ascii.hpp>
+#include <sso/growth_policy.hpp>
+#include <sso/hash.hpp>
+#include <sso/ownership_policy.hpp>
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+//! Comparison and hashing, which ignore case of ASCII letters (e.g. for HTTP header names).
+//! Other characters are compared as is, so results don't depend on locale.
+namespace sso
+{
+
+//! Transparent equality, short `basic_string`s of bytes are compared by folding whole inline buffers
+template <typename Char>
+struct basic_case_insensitive_equal
+{
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr bool
+    operator()(std::basic_string_view<Char> l, std::basic_string_view<Char> r) const noexcept
+    {
+        return detail::ascii::iequals(l, r);
+    }
+
+    template <typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+              ownership_policy Ownership>
+    [[nodiscard]] constexpr bool
+    operator()(basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& l,
+               basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& r) const noexcept
+    {
+        return l.buffer.iequals(r.buffer);
+    }
+};
+
+//! Transparent three-way comparison of strings converted to lower case
+template <typename Char>
+struct basic_case_insensitive_compare
+{
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr std::weak_ordering
+    operator()(std::basic_string_view<Char> l, std::basic_string_view<Char> r) const noexcept
+    {
+        return detail::ascii::icompare(l, r);
+    }
+
+    template <typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+              ownership_policy Ownership>
+    [[nodiscard]] constexpr std::weak_ordering
+    operator()(basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& l,
+               basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& r) const noexcept
+    {
+        return l.buffer.icompare(r.buffer);
+    }
+};
+
+//! Transparent ordering for `std::map`/`std::set`, see `basic_case_insensitive_compare`
+template <typename Char>
+struct basic_case_insensitive_less
+{
+    using is_transparent = void;
+
+    template <typename L, typename R>
+    [[nodiscard]] constexpr bool
+    operator()(L const& l, R const& r) const noexcept
+    {
+        return basic_case_insensitive_compare<Char>{}(l, r) < 0;
+    }
+};
+
+//! Transparent hasher, strings equal by `basic_case_insensitive_equal` have equal hashes.
+//! For byte characters result is the same as of `basic_fast_hash` of string converted to lower case,
+//! but no copy is made: words are folded as they are loaded. Wider characters are folded by chunks,
+//! which are hashed and mixed, so their hashes differ from `basic_fast_hash` of lower case string
+template <typename Char>
+struct basic_case_insensitive_hash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t
+    operator()(std::basic_string_view<Char> str) const noexcept
+    {
+        if constexpr (detail::byte_char<Char>)
+        {
+            return static_cast<std::size_t>(detail::hash_bytes(reinterpret_cast<std::byte const*>(str.data()),
+                                                               str.size(), detail::ascii::word_folder{}));
+        } else
+        {
+            // bytes of wider characters can't be folded separately, so characters are folded by chunks
+            constexpr std::size_t chunk_size{ 32 };
+            std::uint64_t seed{ detail::hash_secret[0] ^ str.size() };
+            for (std::size_t offset{ 0 }; offset < str.size(); offset += chunk_size)
+            {
+                std::array<Char, chunk_size> chunk;
+                auto const chunk_end{ std::ranges::transform(str.substr(offset, chunk_size), chunk.begin(),
+                                                             detail::ascii::fold<Char>)
+                                          .out };
+                auto const bytes{ static_cast<std::size_t>(chunk_end - chunk.begin()) * sizeof(Char) };
+                seed = detail::hash_mix(
+                    seed ^ detail::hash_secret[1],
+                    detail::hash_bytes(reinterpret_cast<std::byte const*>(chunk.data()), bytes));
+            }
+
+            return static_cast<std::size_t>(seed);
+        }
+    }
+
+    [[nodiscard]] std::size_t
+    operator()(Char const* str) const noexcept
+    {
+        return (*this)(std::basic_string_view<Char>{ str });
+    }
+
+    //! Short string of bytes is hashed directly from inline buffer, see `basic_fast_hash`
+    template <typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+              ownership_policy Ownership>
+    [[nodiscard]] std::size_t
+    operator()(basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& str) const noexcept
+    {
+        if constexpr (detail::byte_char<Char>)
+        {
+            auto const& buffer{ str.buffer };
+            if (auto const size{ buffer.length() }; buffer.is_inline() && size < detail::small_hash_bytes)
+            {
+                return static_cast<std::size_t>(
+                    detail::hash_small(buffer.representation().data(), size, detail::ascii::word_folder{}));
+            }
+        }
+
+        return (*this)(static_cast<std::basic_string_view<Char>>(str));
+    }
+};
+
+using case_insensitive_equal = basic_case_insensitive_equal<char>;
+using case_insensitive_compare = basic_case_insensitive_compare<char>;
+using case_insensitive_less = basic_case_insensitive_less<char>;
+using case_insensitive_hash = basic_case_insensitive_hash<char>;
+
+//! Strings, which may be compared ignoring case: `basic_string`, `std::basic_string_view`, `std::basic_string`,
+//! C strings and string literals
+template <typename String, typename Char>
+concept string_of = std::convertible_to<String const&, std::basic_string_view<Char>>;
+
+namespace detail
+{
+
+//! Character type of string class, C string or array of characters (e.g. string literal)
+template <typename String>
+struct string_char
+{
+};
+
+template <typename String>
+    requires requires { typename String::value_type; }
+struct string_char<String>
+{
+    using type = typename String::value_type;
+};
+
+template <typename Char>
+struct string_char<Char*>
+{
+    using type = std::remove_const_t<Char>;
+};
+
+template <typename Char, std::size_t N>
+struct string_char<Char[N]>
+{
+    using type = std::remove_const_t<Char>;
+};
+
+//! Character type of the first operand, which has one, so literal may be on either side
+template <typename L, typename R>
+struct operands_char : string_char<R>
+{
+};
+
+template <typename L, typename R>
+    requires requires { typename string_char<L>::type; }
+struct operands_char<L, R> : string_char<L>
+{
+};
+
+} // namespace detail
+
+//! @return `true` if `l` and `r` are equal ignoring case of ASCII letters
+template <typename L, typename R, typename Char = typename detail::operands_char<L, R>::type>
+    requires string_of<L, Char> && string_of<R, Char>
+[[nodiscard]] constexpr bool
+iequals(L const& l, R const& r) noexcept
+{
+    return basic_case_insensitive_equal<Char>{}(l, r);
+}
+
+//! @return three-way comparison of `l` and `r` converted to lower case
+template <typename L, typename R, typename Char = typename detail::operands_char<L, R>::type>
+    requires string_of<L, Char> && string_of<R, Char>
+[[nodiscard]] constexpr std::weak_ordering
+icompare(L const& l, R const& r) noexcept
+{
+    return basic_case_insensitive_compare<Char>{}(l, r);
+}
+
+} // namespace sso
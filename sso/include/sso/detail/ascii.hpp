@@ -0,0 +1,276 @@
+#pragma once
+
+#include <sso/detail/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//! ASCII case conversion. Only 'A'-'Z' and 'a'-'z' are converted, other characters
+//! (including bytes of multibyte UTF-8 sequences) are kept, so result doesn't depend on locale.
+//! Case-insensitive comparison compares characters converted to lower case.
+namespace sso::detail::ascii
+{
+
+template <bool Upper, typename Char>
+[[nodiscard]] constexpr Char
+convert_char(Char c) noexcept
+{
+    constexpr Char first{ Upper ? 'a' : 'A' };
+
+    return c >= first && c <= first + ('z' - 'a') ? static_cast<Char>(c ^ 0x20) : c;
+}
+
+template <typename Char>
+[[nodiscard]] constexpr Char
+fold(Char c) noexcept
+{
+    return convert_char<false>(c);
+}
+
+//! @return characters, which `std::isspace` accepts in "C" locale.
+//! Literal, since GCC doesn't compare pointers into variable templates in constant evaluation
+template <typename Char>
+[[nodiscard]] constexpr std::basic_string_view<Char>
+whitespace() noexcept
+{
+    if constexpr (std::is_same_v<Char, wchar_t>) return L" \t\n\v\f\r";
+    else if constexpr (std::is_same_v<Char, char8_t>) return u8" \t\n\v\f\r";
+    else if constexpr (std::is_same_v<Char, char16_t>) return u" \t\n\v\f\r";
+    else if constexpr (std::is_same_v<Char, char32_t>) return U" \t\n\v\f\r";
+    else return " \t\n\v\f\r";
+}
+
+//! @return word, each byte of which is `value`
+[[nodiscard]] constexpr std::uint64_t
+repeat(byte value) noexcept
+{
+    return 0x0101010101010101ull * value;
+}
+
+//! Converts 8 byte characters at once, without branching (SWAR)
+template <bool Upper>
+[[nodiscard]] constexpr std::uint64_t
+convert_word(std::uint64_t word) noexcept
+{
+    constexpr byte first{ Upper ? 'a' : 'A' };
+
+    // adding to 7 low bits doesn't carry into next byte, high bit of result tells if byte is in range
+    auto const low_bits{ word & repeat(0x7f) };
+    auto const at_least_first{ low_bits + repeat(0x80 - first) };
+    auto const after_last{ low_bits + repeat(0x80 - first - ('z' - 'a' + 1)) };
+    auto const letters{ at_least_first & ~after_last & ~word & repeat(0x80) };
+
+    // 0x80 >> 2 is the case bit
+    return word ^ (letters >> 2);
+}
+
+[[nodiscard]] constexpr std::uint64_t
+fold_word(std::uint64_t word) noexcept
+{
+    return convert_word<false>(word);
+}
+
+//! Function object for `hash_bytes`
+struct word_folder
+{
+    [[nodiscard]] constexpr std::uint64_t
+    operator()(std::uint64_t word) const noexcept
+    {
+        return fold_word(word);
+    }
+};
+
+#if defined(SSO_SIMD_SSE2)
+
+template <bool Upper>
+[[nodiscard]] inline __m128i
+convert_sse2(__m128i block) noexcept
+{
+    constexpr char first{ Upper ? 'a' : 'A' };
+
+    // moves letters to the lowest signed values, so range is checked by single comparison
+    auto const shifted{ _mm_sub_epi8(block, _mm_set1_epi8(static_cast<char>(first - 128))) };
+    auto const letters{ _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + ('z' - 'a' + 1))) };
+
+    return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+
+#endif
+
+#if defined(SSO_SIMD_AVX2)
+
+template <bool Upper>
+[[gnu::target("avx2")]] [[nodiscard]] inline __m256i
+convert_avx2(__m256i block) noexcept
+{
+    constexpr char first{ Upper ? 'a' : 'A' };
+
+    auto const shifted{ _mm256_sub_epi8(block, _mm256_set1_epi8(static_cast<char>(first - 128))) };
+    auto const letters{ _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + ('z' - 'a' + 1)), shifted) };
+
+    return _mm256_xor_si256(block, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+}
+
+//! @return number of converted bytes, multiple of 32
+template <bool Upper>
+[[gnu::target("avx2")]] std::size_t
+convert_avx2(byte* data, std::size_t size) noexcept
+{
+    std::size_t i{ 0 };
+    for (; i + 32 <= size; i += 32)
+    {
+        auto* const block{ reinterpret_cast<__m256i*>(data + i) };
+        _mm256_storeu_si256(block, convert_avx2<Upper>(_mm256_loadu_si256(block)));
+    }
+
+    return i;
+}
+
+//! @return index of first folded mismatch, or number of compared bytes (multiple of 32), if there is none
+[[gnu::target("avx2")]] inline std::size_t
+mismatch_avx2(byte const* l, byte const* r, std::size_t size) noexcept
+{
+    std::size_t i{ 0 };
+    for (; i + 32 <= size; i += 32)
+    {
+        auto const l_block{ convert_avx2<false>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(l + i))) };
+        auto const r_block{ convert_avx2<false>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(r + i))) };
+        auto const equal{ static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(l_block, r_block))) };
+        if (equal != ~std::uint32_t{}) return i + static_cast<std::size_t>(std::countr_one(equal));
+    }
+
+    return i;
+}
+
+#endif
+
+//! Converts byte characters by 32 (AVX2) or 16 (SSE2) at once, the rest - by words
+template <bool Upper>
+inline void
+convert_bytes(byte* data, std::size_t size) noexcept
+{
+    std::size_t i{ 0 };
+#if defined(SSO_SIMD_AVX2)
+    if (size >= 32 && has_avx2()) i = convert_avx2<Upper>(data, size);
+#endif
+#if defined(SSO_SIMD_SSE2)
+    for (; i + 16 <= size; i += 16)
+    {
+        auto* const block{ reinterpret_cast<__m128i*>(data + i) };
+        _mm_storeu_si128(block, convert_sse2<Upper>(_mm_loadu_si128(block)));
+    }
+#endif
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        word = convert_word<Upper>(word);
+        std::memcpy(data + i, &word, sizeof(word));
+    }
+    for (; i < size; ++i) data[i] = convert_char<Upper>(data[i]);
+}
+
+//! @return index of the first byte, which differs after folding, or `size`
+[[nodiscard]] inline std::size_t
+mismatch_bytes(byte const* l, byte const* r, std::size_t size) noexcept
+{
+    std::size_t i{ 0 };
+#if defined(SSO_SIMD_AVX2)
+    if (size >= 32 && has_avx2())
+    {
+        // the rest is compared below
+        if (i = mismatch_avx2(l, r, size); i < size - size % 32) return i;
+    }
+#endif
+#if defined(SSO_SIMD_SSE2)
+    for (; i + 16 <= size; i += 16)
+    {
+        auto const l_block{ convert_sse2<false>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(l + i))) };
+        auto const r_block{ convert_sse2<false>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(r + i))) };
+        auto const equal{ static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(l_block, r_block))) };
+        if (equal != 0xffff) return i + static_cast<std::size_t>(std::countr_one(equal));
+    }
+#endif
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t l_word, r_word;
+        std::memcpy(&l_word, l + i, sizeof(l_word));
+        std::memcpy(&r_word, r + i, sizeof(r_word));
+        if (auto const difference{ fold_word(l_word) ^ fold_word(r_word) }; difference != 0)
+        {
+            auto const bits{ std::endian::native == std::endian::little ? std::countr_zero(difference)
+                                                                         : std::countl_zero(difference) };
+
+            return i + static_cast<std::size_t>(bits) / 8;
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (fold(l[i]) != fold(r[i])) return i;
+    }
+
+    return size;
+}
+
+//! @return index of the first character, which differs after folding, or `size`
+template <typename Char>
+[[nodiscard]] constexpr std::size_t
+mismatch(Char const* l, Char const* r, std::size_t size) noexcept
+{
+    if constexpr (byte_char<Char>)
+    {
+        if (!std::is_constant_evaluated()) return mismatch_bytes(bytes(l), bytes(r), size);
+    }
+
+    for (std::size_t i{ 0 }; i < size; ++i)
+    {
+        if (fold(l[i]) != fold(r[i])) return i;
+    }
+
+    return size;
+}
+
+template <bool Upper, typename Char>
+constexpr void
+convert(Char* data, std::size_t size) noexcept
+{
+    if constexpr (byte_char<Char>)
+    {
+        if (!std::is_constant_evaluated()) return convert_bytes<Upper>(bytes(data), size);
+    }
+
+    std::ranges::transform(data, data + size, data, convert_char<Upper, Char>);
+}
+
+template <typename Char>
+[[nodiscard]] constexpr bool
+iequals(std::basic_string_view<Char> l, std::basic_string_view<Char> r) noexcept
+{
+    return l.size() == r.size() && mismatch(l.data(), r.data(), l.size()) == l.size();
+}
+
+//! Compares folded characters the same way as `std::basic_string_view`
+template <typename Char>
+[[nodiscard]] constexpr std::weak_ordering
+icompare(std::basic_string_view<Char> l, std::basic_string_view<Char> r) noexcept
+{
+    auto const size{ std::min(l.size(), r.size()) };
+    if (auto const i{ mismatch(l.data(), r.data(), size) }; i != size)
+    {
+        auto const l_char{ fold(l[i]) };
+        auto const r_char{ fold(r[i]) };
+
+        return std::char_traits<Char>::compare(&l_char, &r_char, 1) <=> 0;
+    }
+
+    return l.size() <=> r.size();
+}
+
+} // namespace sso::detail::ascii
@@ -1,22 +1,43 @@
 #pragma once
 
+#include <sso/detail/ascii.hpp>
+#include <sso/growth_policy.hpp>
+#include <sso/ownership_policy.hpp>
+#include <sso/relocate.hpp>
 #include <sso/util.hpp>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <version>
 
 namespace sso::detail
 {
 
-template <typename Char, typename Allocator>
-struct basic_string_buffer
+//! @tparam InlineCapacity minimal number of characters (excluding null-terminator), which are stored
+//!         without allocation. Actual inline capacity can be greater, see `inline_capacity()`
+//! @tparam Ownership decides whether copies share heap buffer, see `shared_ownership`
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership>
+struct SSO_TRIVIAL_ABI basic_string_buffer
 {
 private:
     using allocator_traits = std::allocator_traits<Allocator>;
 
+    static constexpr bool trivially_destructible{ monotonic_allocator<Allocator> && !Ownership::shared
+                                                  && std::is_trivially_destructible_v<Allocator> };
+
 public:
     using size_type = allocator_traits::size_type;
     using value_type = allocator_traits::value_type;
@@ -30,15 +51,26 @@ public:
 
     using string_view = std::basic_string_view<Char>;
 
+    //! Copies inline buffer as a whole.
+    //! Shares `other`'s heap buffer if `Ownership` allows it and allocators are equal
     constexpr basic_string_buffer(basic_string_buffer const& other)
-        : basic_string_buffer(static_cast<string_view>(other))
+        : basic_string_buffer{ allocator_traits::select_on_container_copy_construction(other.allocator()) }
     {
+        if (other.is_inline())
+        {
+            storage_ = other.storage_;
+        } else if (can_share(other))
+        {
+            share(other);
+        } else
+        {
+            assign_exact(other.view());
+        }
     }
 
     explicit constexpr basic_string_buffer(allocator_type const& allocator) noexcept(std::is_nothrow_constructible_v<allocator_type>)
         : allocator_(allocator)
     {
-        set_short();
         construct_short();
 
         assert(!is_long());
@@ -49,18 +81,14 @@ public:
     {
     }
 
+    //! Takes ownership of `other`'s heap buffer, if any.
+    //! Complexity: O(1)
+    //! @post `other.length() == 0`
     constexpr basic_string_buffer(basic_string_buffer&& other) noexcept
-        : basic_string_buffer{ other.get_allocator() }
+        : storage_{ other.storage_ }
+        , allocator_{ std::move(other.allocator_) }
     {
-        if (other.is_long())
-        {
-            set_long();
-            *construct_long() = *other.get_long();
-        } else
-        {
-            set_short();
-            *construct_short() = *other.get_short();
-        }
+        other.construct_short();
     }
 
     constexpr basic_string_buffer(size_type size, value_type value,
@@ -70,45 +98,88 @@ public:
         resize(size, value);
     }
 
-    explicit constexpr basic_string_buffer(string_view other)
-        : basic_string_buffer{}
+    explicit constexpr basic_string_buffer(string_view other, allocator_type const& allocator = allocator_type())
+        : basic_string_buffer{ allocator }
+    {
+        assign_exact(other);
+    }
+
+    //! Shares `other`'s heap buffer if `Ownership` allows it and allocators are equal.
+    //! Otherwise reuses current capacity if it is enough and allocator isn't replaced
+    constexpr basic_string_buffer&
+    operator=(basic_string_buffer const& other)
     {
-        if (other.size() >= short_buf::capacity)
+        if (this == &other) return *this;
+
+        if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
         {
-            set_long();
-            construct_long();
+            // memory must be freed by allocator, which allocated it
+            if (allocator() != other.allocator())
+            {
+                destroy();
+                construct_short();
+            }
+            allocator() = other.allocator();
+        }
+
+        if (can_share(other))
+        {
+            share(other);
         } else
         {
-            set_short();
-            construct_short();
+            replace(0, length(), other.view());
         }
 
-        reserve(other.size());
-        set_length(other.length());
-        std::ranges::copy(other, begin());
+        return *this;
     }
 
+    //! Takes ownership of `other`'s heap buffer, if allocators allow it.
+    //! Otherwise elements are copied.
+    //! @post `other.length() == 0`
     constexpr basic_string_buffer&
-    operator=(basic_string_buffer other)
+    operator=(basic_string_buffer&& other) noexcept(
+        allocator_traits::propagate_on_container_move_assignment::value
+        || allocator_traits::is_always_equal::value)
     {
-        swap(*this, other);
+        if (this == &other) return *this;
+
+        if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+        {
+            destroy();
+            allocator() = std::move(other.allocator());
+        } else if (allocator() != other.allocator())
+        {
+            // not `*this = other`, which can propagate allocator on copy assignment
+            replace(0, length(), other.view());
+            other.clear();
+
+            return *this;
+        } else
+        {
+            destroy();
+        }
+
+        storage_ = other.storage_;
+        other.construct_short();
 
         return *this;
     }
 
-    constexpr basic_string_buffer& operator=(basic_string_buffer&&) = delete;
+    //! Nothing to free if `Allocator` is monotonic
+    ~basic_string_buffer() requires trivially_destructible = default;
 
-    ~basic_string_buffer()
+    constexpr ~basic_string_buffer()
     {
         destroy();
     }
 
+    //! Complexity: O(1), without branching on representation
     [[nodiscard]] constexpr size_type
     length() const
     {
-        if (is_long()) return get_long()->length();
+        if (std::is_constant_evaluated()) return short_length();
 
-        return get_short()->length();
+        return select(is_long(), peek<size_type>(offsetof(long_buf, size_)), short_length());
     }
 
     [[nodiscard]] constexpr size_type
@@ -121,18 +192,21 @@ public:
     [[nodiscard]] constexpr const_pointer
     data() const noexcept
     {
-        if (is_long()) return get_long()->data();
+        if (std::is_constant_evaluated()) return short_data();
 
-        return get_short()->data();
+        return select(is_long(), const_pointer{ peek<pointer>(offsetof(long_buf, data_)) },
+                      short_data());
     }
 
     //! @return [ `data()`, `data() + size()` ).
+    //!         Detaches shared heap buffer and makes it unshareable, see `shared_ownership`
     [[nodiscard]] constexpr pointer
-    data() noexcept
+    data() noexcept(!Ownership::shared)
     {
-        if (is_long()) return get_long()->data();
+        detach();
+        leak();
 
-        return get_short()->data();
+        return raw_data();
     }
 
     [[nodiscard]] constexpr allocator_type
@@ -141,12 +215,146 @@ public:
         return allocator();
     }
 
+    //! @return `true` if characters are stored inside `*this`, in `representation()`
+    [[nodiscard]] constexpr bool
+    is_inline() const noexcept
+    {
+        return !is_long();
+    }
+
+    //! @return raw bytes of `*this`. If `is_inline()` characters start at the first byte,
+    //!         bytes after `length()` characters are unspecified
+    [[nodiscard]] auto const&
+    representation() const noexcept
+    {
+        return *reinterpret_cast<representation_type const*>(&storage_);
+    }
+
+    //! If both strings are short, compares whole inline buffers word by word
+    [[nodiscard]] constexpr bool
+    equals(basic_string_buffer const& other) const noexcept
+    {
+        if constexpr (word_comparable)
+        {
+            if (is_inline() && other.is_inline())
+            {
+                word_type difference{};
+                for (size_type i{ 0 }; i < std::tuple_size_v<words_type>; ++i)
+                {
+                    difference |= word(i) ^ other.word(i);
+                }
+
+                return difference == 0;
+            }
+        }
+
+        return view() == other.view();
+    }
+
+    //! If both strings are short and consist of bytes, compares whole inline buffers
+    //! word by word, as big-endian integers
+    [[nodiscard]] constexpr auto
+    compare(basic_string_buffer const& other) const noexcept -> decltype(string_view{} <=> string_view{})
+    {
+        if constexpr (word_comparable && bytewise_ordered)
+        {
+            if (is_inline() && other.is_inline())
+            {
+                auto const l{ ordered_words() };
+                auto const r{ other.ordered_words() };
+                if (auto const cmp{ l <=> r }; cmp != 0) return cmp;
+
+                return short_length() <=> other.short_length();
+            }
+        }
+
+        return view() <=> other.view();
+    }
+
+    //! Equality ignoring case of ASCII letters.
+    //! If both strings are short and consist of bytes, folds whole inline buffers word by word.
+    [[nodiscard]] constexpr bool
+    iequals(basic_string_buffer const& other) const noexcept
+    {
+        if constexpr (word_comparable && byte_char<value_type>)
+        {
+            if (is_inline() && other.is_inline())
+            {
+                auto const l{ folded_words() };
+                auto const r{ other.folded_words() };
+                word_type difference{};
+                for (size_type i{ 0 }; i < l.size(); ++i) difference |= l[i] ^ r[i];
+
+                return difference == 0;
+            }
+        }
+
+        return ascii::iequals(view(), other.view());
+    }
+
+    //! Three-way comparison of strings converted to lower case, see `compare()`
+    [[nodiscard]] constexpr std::weak_ordering
+    icompare(basic_string_buffer const& other) const noexcept
+    {
+        if constexpr (word_comparable && bytewise_ordered)
+        {
+            if (is_inline() && other.is_inline())
+            {
+                auto const l{ ordered_words(folded_words()) };
+                auto const r{ ordered_words(other.folded_words()) };
+                if (auto const cmp{ l <=> r }; cmp != 0) return cmp;
+
+                return short_length() <=> other.short_length();
+            }
+        }
+
+        return ascii::icompare(view(), other.view());
+    }
+
+    //! Converts ASCII letters to upper case if `Upper`, to lower case otherwise.
+    //! Short string of bytes is converted word by word, without branching on characters.
+    template <bool Upper>
+    constexpr void
+    convert_case() noexcept(!Ownership::shared)
+    {
+        if constexpr (word_comparable && byte_char<value_type>)
+        {
+            if (is_inline())
+            {
+                // bytes after the string are zero, but the last one is spare capacity
+                auto words{ this->words() };
+                auto const spare{ words.back() & spare_mask };
+                for (auto& word : words) word = ascii::convert_word<Upper>(word);
+                words.back() = (words.back() & ~spare_mask) | spare;
+                poke(0, words);
+
+                return;
+            }
+        }
+
+        detach();
+        ascii::convert<Upper>(std::to_address(raw_data()), length());
+    }
+
+    //! Swaps allocators if `propagate_on_container_swap`.
+    //! Otherwise, if allocators aren't equal and any string is long, contents are exchanged by copying,
+    //! see `swap_contents()`
     friend constexpr void
-    swap(basic_string_buffer& l, basic_string_buffer& r) noexcept
+    swap(basic_string_buffer& l, basic_string_buffer& r) noexcept(
+        allocator_traits::propagate_on_container_swap::value || allocator_traits::is_always_equal::value)
     {
         using std::swap;
 
-        swap(l.data_, r.data_);
+        if constexpr (allocator_traits::propagate_on_container_swap::value)
+        {
+            swap(l.allocator_, r.allocator_);
+        } else if (l.allocator() != r.allocator() && !(l.is_inline() && r.is_inline()))
+        {
+            swap_contents(l, r);
+
+            return;
+        }
+        swap(l.storage_, r.storage_);
     }
 
     //! @return null-terminated array [ `data()`, `data() + size()` ]
@@ -156,12 +364,62 @@ public:
         return data();
     }
 
+    //! Keeps capacity, but releases heap buffer if it is shared
+    //! @post `length() == 0`
+    constexpr void
+    clear() noexcept
+    {
+        if (is_shared())
+        {
+            destroy();
+            construct_short();
+
+            return;
+        }
+
+        set_length(0);
+    }
+
+    //! @return maximal length of string, which is stored without allocation
+    [[nodiscard]] static constexpr size_type
+    inline_capacity() noexcept
+    {
+        return short_buf::max_size();
+    }
+
     [[nodiscard]] constexpr size_type
     max_size() const
     {
         return std::max(long_buf::max_size(), short_buf::max_size());
     }
 
+    //! Refers to `str` instead of copying it, if it doesn't fit inline buffer.
+    //! Such string is shared with static storage: it is copied on first mutable access, like shared heap buffer
+    //! @pre `length() == 0`, `str` lives until the end of program and is followed by null-terminator
+    constexpr void
+    borrow(string_view str) noexcept
+    {
+        static_assert(Ownership::shared, "string, which refers to static storage, must be copied on mutable access");
+        assert(length() == 0);
+
+        if (str.size() <= inline_capacity())
+        {
+            set_length(str.size());
+            std::ranges::copy(str, raw_data());
+
+            return;
+        }
+
+        auto* const long_buf{ construct_long() };
+        long_buf->data_ = pointer{ const_cast<value_type*>(str.data()) };
+        long_buf->size_ = str.size();
+        long_buf->capacity_ = str.size() + 1;
+        poke(spare_offset, static_flag);
+
+        assert(is_static());
+    }
+
+    //! Unlike implicit growth in `replace`/`resize` this doesn't apply `GrowthPolicy`
     //! @throws `std::length_error` if `count > max_size()`
     constexpr void
     reserve(size_type count)
@@ -170,18 +428,7 @@ public:
         if (count + 1 > max_size())
             throw std::length_error("`count` must not be greater than `max_size()`");
 
-        auto const capacity{ count + 1 };
-        auto* const data{ allocator_traits::allocate(allocator(), capacity) };
-        auto const size{ length() };
-
-        std::ranges::copy(*this, data);
-
-        destroy();
-        set_long();
-        auto* const buf{ construct_long() };
-        buf->capacity_ = capacity;
-        buf->data_ = data;
-        set_length(size);
+        reallocate(count);
     }
 
     [[nodiscard]] constexpr iterator
@@ -209,52 +456,432 @@ public:
     }
 
     //! @pre `pos + count <= lenght()`
-    //! @pre `src` isn't overlap `*this` TODO: get rid of `reserve` to fix this
-    //! @post possible reallocation if `src.size() > count`,
+    //! @post possible reallocation if `length() - count + src.size() > capacity()`,
     //!       If reallocation take place all iterators, pointers, references
     //!       are invalidated. Else invalidates only iterators in range
     //!       [ `begin() + pos` , `end()` ]
+    //! @note `src` is allowed to overlap `*this`
     constexpr void
     replace(size_type pos, size_type count, string_view src)
     {
-        // TODO: optimize by removing `reserve`
         assert(pos + count <= length());
 
+        auto const size{ length() };
         auto const src_size{ std::ranges::size(src) };
-        auto const new_size{ length() + src_size - count };
-        reserve(new_size);
-
-        auto const rest{ *this | std::views::drop(pos + count) };
+        auto const new_size{ size - count + src_size };
 
-        if (count > src_size)
+        if (new_size <= capacity() && !is_shared())
         {
-            std::ranges::move(rest, begin() + pos + src_size);
-        } else if (count < src_size)
+            replace_inplace(pos, count, src);
+            set_length(new_size);
+
+            return;
+        }
+
+        // `src` may point into old buffer, so it must be alive until copy is done
+        auto const old{ view() };
+        auto const copy_result{ [&](value_type* out)
+                                {
+                                    out = std::ranges::copy(old.substr(0, pos), out).out;
+                                    out = std::ranges::copy(src, out).out;
+                                    std::ranges::copy(old.substr(pos + count), out);
+                                } };
+
+        if (new_size <= inline_capacity())
         {
-            std::ranges::move_backward(rest, end() + src_size - count);
+            // shared buffer is released instead of copying short result
+            std::array<value_type, inline_capacity()> chars{};
+            copy_result(chars.data());
+            destroy();
+            construct_short();
+            set_length(new_size);
+            std::ranges::copy_n(chars.data(), new_size, raw_data());
+
+            return;
         }
 
-        std::ranges::copy(src, begin() + pos);
-        set_length(new_size);
+        // shared buffer is copied with exact size, like copy constructor does
+        auto const new_buf{ allocate((new_size > capacity() ? next_capacity(new_size) : new_size) + 1) };
+        copy_result(std::to_address(new_buf.data));
+
+        adopt(new_buf, new_size);
     }
 
     constexpr void
     resize(size_type size, value_type filler = value_type{})
     {
-        reserve(size);
+        // shortened shared buffer may be released, see `replace`
+        if (auto const old_size{ length() }; size <= old_size)
+        {
+            replace(size, old_size - size, string_view{});
+
+            return;
+        }
+
+        grow(size);
+        detach();
 
-        if (size > length())
+        if (auto const old_size{ length() }; size > old_size)
         {
-            std::fill_n(begin() + length(), size, filler);
+            std::fill_n(raw_data() + old_size, size - old_size, filler);
         }
 
         set_length(size);
     }
 
+    //! Lets `op` write characters directly into buffer, like `std::basic_string::resize_and_overwrite` (C++23).
+    //! `op(data, count)` gets [ `data`, `data + count` ), where first `min(length(), count)` characters
+    //! are the current ones and the rest are uninitialized, and returns new length.
+    //! @pre `op` returns value in [ 0, `count` ] and doesn't throw
+    //! @post `length()` is the value returned by `op`
+    //! @throws `std::length_error` if `count > max_size()`
+    template <typename Operation>
+    constexpr void
+    resize_and_overwrite(size_type count, Operation op)
+    {
+        grow(count);
+        detach();
+
+        auto* const data{ std::to_address(raw_data()) };
+        auto const size{ static_cast<size_type>(std::move(op)(data, count)) };
+        assert(size <= count);
+
+        // inline characters after the string must stay zero, `set_length` clears only the old ones
+        if (is_inline() && size < count) std::fill(data + size, data + count, value_type{});
+        set_length(size);
+    }
+
+    //! Like `resize`, but new characters are left as is: they are unspecified for long string
+    //! and zero for short one. Complexity: O(1) unless reallocation takes place
+    //! @post `length() == size`
+    //! @throws `std::length_error` if `size > max_size()`
+    constexpr void
+    resize_uninitialized(size_type size)
+    {
+        grow(size);
+        detach();
+        set_length(size);
+    }
+
 private:
     struct long_buf;
     struct short_buf;
 
+    //! Last byte of `storage_` is shared by both representations.
+    //! In short mode it stores spare capacity (see `short_buf`), which is always less than `long_flag`
+    static constexpr std::byte long_flag{ 0x80 };
+
+    //! Last byte of long string, which refers to static storage instead of owned heap buffer, see `borrow()`
+    static constexpr std::byte static_flag{ long_flag | std::byte{ 0x40 } };
+
+    //! Fits `long_buf` and at least `InlineCapacity + 1` characters, padded to whole words
+    static constexpr std::size_t representation_size{ std::max(
+        sizeof(long_buf),
+        ((InlineCapacity + 1) * sizeof(Char) + alignof(long_buf) - 1) / alignof(long_buf) * alignof(long_buf)) };
+
+    using representation_type = std::array<std::byte, representation_size>;
+
+    //! Offset of the byte, which is shared by both representations, see `long_flag`
+    static constexpr std::size_t spare_offset{ representation_size - 1 };
+
+    union storage;
+
+    struct allocation
+    {
+        pointer data;
+        size_type count;
+    };
+
+    //! Placed before characters in heap buffer if `Ownership::shared`
+    struct shared_header
+    {
+        //! Number of owners, or `unshareable` if the only owner has given out mutable access, see `leak()`
+        std::atomic<size_type> references{ 1 };
+    };
+
+    //! Value of `shared_header::references`, which can't be reached by counting owners
+    static constexpr size_type unshareable{ 0 };
+
+    using header_allocator = allocator_traits::template rebind_alloc<shared_header>;
+    using header_traits = std::allocator_traits<header_allocator>;
+
+    //! @return number of `shared_header`s, which fit header followed by `count` elements
+    [[nodiscard]] static constexpr size_type
+    header_blocks(size_type count) noexcept
+    {
+        return 1 + (count * sizeof(value_type) + sizeof(shared_header) - 1) / sizeof(shared_header);
+    }
+
+    //! @pre `Ownership::shared`, `is_long()`
+    [[nodiscard]] constexpr shared_header*
+    header() const noexcept
+    {
+        return reinterpret_cast<shared_header*>(std::to_address(get_long()->data_)) - 1;
+    }
+
+    //! @return `true` if characters refer to static storage, see `borrow()`
+    [[nodiscard]] constexpr bool
+    is_static() const noexcept
+    {
+        if constexpr (Ownership::shared)
+        {
+            return peek<std::byte>(spare_offset) == static_flag;
+        } else
+        {
+            return false;
+        }
+    }
+
+    //! @return `true` if heap buffer is shared with other strings or characters are in static storage
+    [[nodiscard]] constexpr bool
+    is_shared() const noexcept
+    {
+        if constexpr (Ownership::shared)
+        {
+            // pairs with release in `deallocate`, so reads of former owners happen before our writes
+            return is_long() && (is_static() || header()->references.load(std::memory_order_acquire) > 1);
+        } else
+        {
+            return false;
+        }
+    }
+
+    //! @return `true` if `*this` can share `other`'s heap buffer
+    [[nodiscard]] constexpr bool
+    can_share(basic_string_buffer const& other) const noexcept
+    {
+        if constexpr (Ownership::shared)
+        {
+            // static storage doesn't belong to any allocator
+            return other.is_long()
+                && (other.is_static()
+                    || (allocator() == other.allocator()
+                        && other.header()->references.load(std::memory_order_relaxed) != unshareable));
+        } else
+        {
+            return false;
+        }
+    }
+
+    //! Releases current buffer and becomes one more owner of `other`'s heap buffer
+    //! (or refers to the same static storage)
+    //! @pre `can_share(other)`
+    constexpr void
+    share(basic_string_buffer const& other) noexcept
+    {
+        // `other` is already an owner, so counter can't drop to zero concurrently
+        if (!other.is_static()) other.header()->references.fetch_add(1, std::memory_order_relaxed);
+        destroy();
+        storage_ = other.storage_;
+    }
+
+    //! Exchanges contents by copying, so each buffer keeps memory of its allocator
+    //! and reuses its capacity if it is enough
+    static constexpr void
+    swap_contents(basic_string_buffer& l, basic_string_buffer& r)
+    {
+        // temporary copy of shorter string is likely inline
+        auto& shorter{ l.length() <= r.length() ? l : r };
+        auto& longer{ &shorter == &l ? r : l };
+
+        basic_string_buffer tmp{ shorter.allocator() };
+        tmp.assign_exact(shorter.view());
+        shorter.replace(0, shorter.length(), longer.view());
+        longer.replace(0, longer.length(), tmp.view());
+    }
+
+    //! Copies heap buffer if it is shared, so `*this` is its only owner
+    constexpr void
+    detach()
+    {
+        if (is_shared()) reallocate(capacity());
+    }
+
+    //! Forbids sharing of heap buffer, since characters can be modified through references given out
+    //! by mutable access, so copies must not see them (like "leaked" state of old libstdc++ `std::string`).
+    //! Buffer becomes shareable again, when it is reallocated
+    //! @pre `!is_shared()`
+    constexpr void
+    leak() noexcept
+    {
+        if constexpr (Ownership::shared)
+        {
+            if (is_long()) header()->references.store(unshareable, std::memory_order_relaxed);
+        }
+    }
+
+    //! @pre `length() == 0`
+    //! @post `length() == src.size()`, capacity is exactly `src.size()` if it is allocated
+    constexpr void
+    assign_exact(string_view src)
+    {
+        reserve(src.size());
+        set_length(src.length());
+        std::ranges::copy(src, raw_data());
+    }
+
+    //! Same as `reserve`, but new capacity is chosen by `GrowthPolicy`
+    //! @throws `std::length_error` if `count > max_size()`
+    constexpr void
+    grow(size_type count)
+    {
+        if (count + 1 <= real_capacity()) return;
+
+        reallocate(next_capacity(count));
+    }
+
+    //! @return capacity, which should be allocated to fit `count` elements according to `GrowthPolicy`
+    //! @pre `count > capacity()`
+    //! @throws `std::length_error` if `count > max_size()`
+    [[nodiscard]] constexpr size_type
+    next_capacity(size_type count) const
+    {
+        if (count + 1 > max_size())
+            throw std::length_error("`count` must not be greater than `max_size()`");
+
+        return std::clamp<size_type>(GrowthPolicy::grow(capacity(), count), count, max_size() - 1);
+    }
+
+    //! @pre `count >= length()`
+    //! @post `is_long()`, `capacity() >= count`
+    constexpr void
+    reallocate(size_type count)
+    {
+        auto const new_buf{ allocate(count + 1) };
+        std::ranges::copy(view(), std::to_address(new_buf.data));
+
+        adopt(new_buf, length());
+    }
+
+    //! Releases current buffer and takes ownership of `buf`, which already contains `size` elements
+    //! @pre `size < buf.count`
+    //! @post `is_long()`, `length() == size`
+    constexpr void
+    adopt(allocation const& buf, size_type size)
+    {
+        destroy();
+        auto* const long_buf{ construct_long() };
+        long_buf->capacity_ = buf.count;
+        long_buf->data_ = buf.data;
+        set_long();
+        set_length(size);
+    }
+
+    //! @pre `length() - count + src.size() <= capacity()`
+    //! @post content is replaced, but length isn't updated
+    constexpr void
+    replace_inplace(size_type pos, size_type count, string_view src)
+    {
+        using traits = std::char_traits<value_type>;
+
+        auto* const hole{ std::to_address(raw_data()) + pos };
+        auto const src_size{ src.size() };
+        auto const tail_size{ length() - pos - count };
+
+        if (!overlaps(src))
+        {
+            if (tail_size != 0 && count != src_size)
+                traits::move(hole + src_size, hole + count, tail_size);
+            if (src_size != 0) traits::copy(hole, src.data(), src_size);
+
+            return;
+        }
+
+        // `src` points into `*this`, so shifting tail can move it
+        if (src_size != 0 && src_size <= count) traits::move(hole, src.data(), src_size);
+        if (tail_size != 0 && count != src_size)
+            traits::move(hole + src_size, hole + count, tail_size);
+        if (src_size > count)
+        {
+            auto const* const src_first{ src.data() };
+            auto const* const src_last{ src_first + src_size };
+            auto const* const hole_last{ hole + count };
+
+            if (!std::less<>{}(hole_last, src_last))
+            {
+                // `src` is before tail, so it wasn't moved
+                traits::move(hole, src_first, src_size);
+            } else if (!std::less<>{}(src_first, hole_last))
+            {
+                // `src` is inside tail, so it was moved by `src_size - count`
+                traits::copy(hole, src_first + (src_size - count), src_size);
+            } else
+            {
+                // `src` crosses end of replaced range
+                auto const left_size{ static_cast<size_type>(hole_last - src_first) };
+                traits::move(hole, src_first, left_size);
+                traits::copy(hole + left_size, hole + src_size, src_size - left_size);
+            }
+        }
+    }
+
+    //! @return true if `src` points into current buffer
+    [[nodiscard]] constexpr bool
+    overlaps(string_view src) const noexcept
+    {
+        auto const* const first{ std::to_address(data()) };
+        auto const* const last{ first + length() };
+        if (std::is_constant_evaluated())
+        {
+            // unrelated pointers can't be ordered in constant evaluation, but can be compared for equality
+            return std::ranges::find(first, last, src.data(), [](auto const& c) { return &c; }) != last;
+        }
+
+        return !std::less<>{}(src.data(), first) && std::less<>{}(src.data(), last);
+    }
+
+    //! @return allocated memory and its real size, which can be greater than `count`
+    //!         if allocator supports `allocate_at_least`
+    //! @throws `std::length_error` in constant evaluation, which uses only short representation
+    [[nodiscard]] constexpr allocation
+    allocate(size_type count)
+    {
+        if (std::is_constant_evaluated())
+            throw std::length_error("string must fit inline buffer in constant evaluation");
+
+        if constexpr (Ownership::shared)
+        {
+            header_allocator headers{ allocator() };
+            auto const blocks{ header_blocks(count) };
+            auto* const header{ std::construct_at(std::to_address(header_traits::allocate(headers, blocks))) };
+
+            return { std::pointer_traits<pointer>::pointer_to(*reinterpret_cast<value_type*>(header + 1)),
+                     (blocks - 1) * sizeof(shared_header) / sizeof(value_type) };
+        }
+
+#if __cpp_lib_allocate_at_least >= 202302L
+        auto const [data, real_count]{ allocator_traits::allocate_at_least(allocator(), count) };
+
+        return { data, std::min(real_count, max_size()) };
+#else
+        return { allocator_traits::allocate(allocator(), count), count };
+#endif
+    }
+
+    //! Releases heap buffer of `count` elements. If it is shared, only decrements reference counter
+    constexpr void
+    deallocate(pointer data, size_type count)
+    {
+        if constexpr (Ownership::shared)
+        {
+            auto* const header{ reinterpret_cast<shared_header*>(std::to_address(data)) - 1 };
+            // unshareable buffer has the only owner. Otherwise release pairs with acquire of the last owner,
+            // so all accesses happen before deallocation
+            if (header->references.load(std::memory_order_relaxed) != unshareable
+                && header->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            std::destroy_at(header);
+            header_allocator headers{ allocator() };
+            header_traits::deallocate(
+                headers, std::pointer_traits<typename header_traits::pointer>::pointer_to(*header),
+                header_blocks(count));
+        } else
+        {
+            allocator_traits::deallocate(allocator(), data, count);
+        }
+    }
+
     [[nodiscard]] constexpr size_type
     real_capacity() const
     {
@@ -268,7 +895,7 @@ private:
     {
         if (is_long())
         {
-            allocator_traits::deallocate(allocator(), data(), capacity() + 1);
+            if (!is_static()) deallocate(get_long()->data_, real_capacity());
             std::destroy_at(get_long());
         } else
         {
@@ -279,50 +906,196 @@ private:
     constexpr long_buf*
     construct_long()
     {
-        return std::construct_at(reinterpret_cast<long_buf*>(data_.data()));
+        return std::construct_at(&storage_.long_);
     }
 
     constexpr short_buf*
     construct_short()
     {
-        return std::construct_at(reinterpret_cast<short_buf*>(data_.data()));
+        return std::construct_at(&storage_.short_);
     }
 
     [[nodiscard]] constexpr bool
     is_long() const
     {
-        return data_.back() != std::byte{};
+        return (peek<std::byte>(spare_offset) & long_flag) != std::byte{};
     }
 
+    //! @pre `long_buf` is constructed in `storage_`
     //! @post `is_long()`
     constexpr void
     set_long()
     {
-        data_.back() = std::byte{ 1 };
+        poke(spare_offset, long_flag);
 
         assert(is_long());
     }
 
-    //! @post `!is_long()`
+    //! @pre `capacity() >= size`
+    //! @post `length() == size`
     constexpr void
-    set_short()
+    set_length(size_type size)
+    {
+        assert(capacity() >= size);
+
+        if (is_long())
+        {
+            get_long()->set_length(size);
+        } else
+        {
+            get_short()->set_length(size);
+        }
+
+        assert(length() == size);
+    }
+
+    using word_type = std::uint64_t;
+    using words_type = std::array<word_type, sizeof(representation_type) / sizeof(word_type)>;
+
+    //! inline buffer can be loaded as words
+    static constexpr bool word_comparable{ sizeof(representation_type) % sizeof(word_type) == 0 };
+    //! selects the last byte of `storage_` in the last word
+    static constexpr word_type spare_mask{ std::endian::native == std::endian::little ? word_type{ 0xff } << 56
+                                                                                      : word_type{ 0xff } };
+    //! `string_view` comparison of `Char` is the same as comparison of unsigned bytes
+    static constexpr bool bytewise_ordered{ std::is_same_v<value_type, char>
+                                            || std::is_same_v<value_type, char8_t>
+                                            || std::is_same_v<value_type, unsigned char> };
+
+    [[nodiscard]] constexpr string_view
+    view() const noexcept
+    {
+        return { std::to_address(data()), length() };
+    }
+
+    //! @return `i`-th word of `storage_`
+    [[nodiscard]] constexpr word_type
+    word(size_type i) const noexcept
+    {
+        return peek<word_type>(i * sizeof(word_type));
+    }
+
+    //! @return all words of `storage_`
+    [[nodiscard]] constexpr words_type
+    words() const noexcept
     {
-        data_.back() = std::byte{};
+        words_type result;
+        for (size_type i{ 0 }; i < result.size(); ++i) result[i] = word(i);
 
-        assert(!is_long());
+        return result;
     }
 
-    //! @pre `capacity() >= size`
-    //! @post `length() <= length`, due to possibility of '\0' inside string before `data() + size`
+    //! @pre `!is_long()`
+    //! @return words of inline buffer without last byte, which are compared
+    //!         as integers in the same order as characters
+    [[nodiscard]] constexpr words_type
+    ordered_words() const noexcept
+    {
+        return ordered_words(words());
+    }
+
+    //! @param words of inline buffer, see `words()`
+    [[nodiscard]] static constexpr words_type
+    ordered_words(words_type words) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            for (auto& word : words) word = byteswap(word);
+        }
+        // last byte is spare capacity, not a character
+        words.back() &= ~word_type{ 0xff };
+
+        return words;
+    }
+
+    //! @pre `!is_long()`
+    //! @return words of inline buffer converted to lower case, except the last byte (spare capacity)
+    [[nodiscard]] constexpr words_type
+    folded_words() const noexcept
+    {
+        auto result{ words() };
+        auto const spare{ result.back() & spare_mask };
+        for (auto& word : result) word = ascii::fold_word(word);
+        result.back() = (result.back() & ~spare_mask) | spare;
+
+        return result;
+    }
+
+    //! @return [ `data()`, `data() + size()` ) without detaching shared heap buffer
+    [[nodiscard]] constexpr pointer
+    raw_data() noexcept
+    {
+        if (std::is_constant_evaluated()) return short_data();
+
+        return select(is_long(), peek<pointer>(offsetof(long_buf, data_)), short_data());
+    }
+
+    //! @return object of type `T` at `offset` in `storage_`, whatever representation is active.
+    //!         Used to load it unconditionally and `select` result without branching.
+    template <typename T>
+    [[nodiscard]] constexpr T
+    peek(std::size_t offset) const noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (std::is_constant_evaluated())
+        {
+            // only short representation is used in constant evaluation, see `allocate()`
+            auto const bytes{ std::bit_cast<representation_type>(storage_.short_) };
+            std::array<std::byte, sizeof(T)> value{};
+            std::copy_n(bytes.begin() + offset, sizeof(T), value.begin());
+
+            return std::bit_cast<T>(value);
+        }
+
+        T value;
+        std::memcpy(&value, reinterpret_cast<std::byte const*>(&storage_) + offset, sizeof(value));
+
+        return value;
+    }
+
+    //! Stores `value` at `offset` in `storage_`, counterpart of `peek`
+    template <typename T>
     constexpr void
-    set_length(size_type size)
+    poke(std::size_t offset, T const& value) noexcept
     {
-        assert(capacity() >= size);
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (std::is_constant_evaluated())
+        {
+            auto bytes{ std::bit_cast<representation_type>(storage_.short_) };
+            std::ranges::copy(std::bit_cast<std::array<std::byte, sizeof(T)>>(value), bytes.begin() + offset);
+            storage_.short_ = std::bit_cast<short_buf>(bytes);
+
+            return;
+        }
+
+        std::memcpy(reinterpret_cast<std::byte*>(&storage_) + offset, &value, sizeof(value));
+    }
 
-        if (is_long()) get_long()->size_ = size;
-        *(data() + size) = value_type{};
+    //! @return `short_buf::length()` if `!is_long()`, unspecified value otherwise
+    [[nodiscard]] constexpr size_type
+    short_length() const noexcept
+    {
+        return short_buf::max_size() - std::to_integer<size_type>(peek<std::byte>(spare_offset));
+    }
 
-        assert(length() <= size);
+    //! @return `short_buf::data()` if `!is_long()`, unspecified value otherwise
+    [[nodiscard]] constexpr const_pointer
+    short_data() const noexcept
+    {
+        if (std::is_constant_evaluated()) return storage_.short_.data_.data();
+
+        return reinterpret_cast<const_pointer>(&storage_);
+    }
+
+    //! @return `short_buf::data()` if `!is_long()`, unspecified value otherwise
+    [[nodiscard]] constexpr pointer
+    short_data() noexcept
+    {
+        if (std::is_constant_evaluated()) return storage_.short_.data_.data();
+
+        return reinterpret_cast<pointer>(&storage_);
     }
 
     [[nodiscard]] constexpr allocator_type&
@@ -343,7 +1116,7 @@ private:
     {
         assert(is_long());
 
-        return reinterpret_cast<long_buf const*>(data_.data());
+        return &storage_.long_;
     }
 
     //! @pre `!is_long()`
@@ -352,7 +1125,7 @@ private:
     {
         assert(!is_long());
 
-        return reinterpret_cast<short_buf const*>(data_.data());
+        return &storage_.short_;
     }
 
     [[nodiscard]] constexpr long_buf*
@@ -360,7 +1133,7 @@ private:
     {
         assert(is_long());
 
-        return reinterpret_cast<long_buf*>(data_.data());
+        return &storage_.long_;
     }
 
     //! @pre `!is_long()`
@@ -369,19 +1142,20 @@ private:
     {
         assert(!is_long());
 
-        return reinterpret_cast<short_buf*>(data_.data());
+        return &storage_.short_;
     }
 
-    std::array<std::byte, std::max(sizeof(long_buf), sizeof(short_buf))> data_{};
+    storage storage_{};
 
     [[no_unique_address]] Allocator allocator_;
 };
 
-template <typename Char, typename Allocator>
-struct basic_string_buffer<Char, Allocator>::long_buf
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership>
+struct basic_string_buffer<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>::long_buf
 {
-    using pointer = basic_string_buffer<Char, Allocator>::pointer;
-    using const_pointer = basic_string_buffer<Char, Allocator>::const_pointer;
+    using pointer = basic_string_buffer::pointer;
+    using const_pointer = basic_string_buffer::const_pointer;
 
     [[nodiscard]] constexpr pointer
     data()
@@ -401,6 +1175,14 @@ struct basic_string_buffer<Char, Allocator>::long_buf
         return size_;
     }
 
+    //! @pre `capacity_ > size`
+    constexpr void
+    set_length(size_type size)
+    {
+        size_ = size;
+        data_[size] = value_type{};
+    }
+
     [[nodiscard]] static constexpr size_type
     max_size()
     {
@@ -412,19 +1194,29 @@ struct basic_string_buffer<Char, Allocator>::long_buf
     size_type capacity_ : (sizeof(size_type) - 1) * CHAR_BIT{ 0 };
 };
 
-template <typename Char, typename Allocator>
-struct basic_string_buffer<Char, Allocator>::short_buf
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership>
+struct basic_string_buffer<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>::short_buf
 {
-    static constexpr size_type capacity{ sizeof(long_buf) / sizeof(value_type) };
+    static constexpr size_type capacity{ sizeof(representation_type) / sizeof(value_type) };
     static_assert(capacity > 1);
+    static_assert(capacity - 1 < std::to_integer<size_type>(long_flag),
+                  "spare capacity must fit in last byte, see `basic_string_buffer::long_flag`");
 
 private:
     using container_type = std::array<value_type, capacity>;
+    using value_bytes = std::array<std::byte, sizeof(value_type)>;
 
 public:
     using pointer = container_type::iterator;
     using const_pointer = container_type::const_iterator;
 
+    //! @post `length() == 0`
+    constexpr short_buf() noexcept
+    {
+        set_length(0);
+    }
+
     [[nodiscard]] constexpr pointer
     data()
     {
@@ -440,7 +1232,26 @@ public:
     [[nodiscard]] constexpr size_type
     length() const
     {
-        return std::ranges::find(data_, value_type{}) - std::ranges::begin(data_);
+        return max_size() - std::to_integer<size_type>(std::bit_cast<value_bytes>(data_.back()).back());
+    }
+
+    //! @pre `size <= max_size()`
+    //! @post elements after `size` are zero, see `data_`
+    constexpr void
+    set_length(size_type size)
+    {
+        assert(size <= max_size());
+
+        // `min` only tells compiler that `fill` is in bounds
+        if (auto const old_size{ std::min(length(), max_size()) }; size < old_size)
+        {
+            std::fill(data_.begin() + size, data_.begin() + old_size, value_type{});
+        }
+        data_[size] = value_type{};
+
+        auto bytes{ std::bit_cast<value_bytes>(data_.back()) };
+        bytes.back() = static_cast<std::byte>(max_size() - size);
+        data_.back() = std::bit_cast<value_type>(bytes);
     }
 
     [[nodiscard]] static constexpr size_type
@@ -449,7 +1260,21 @@ public:
         return capacity - 1;
     }
 
-    std::array<value_type, capacity - 1> data_{};
+    //! Last byte of `data_` stores `max_size() - length()`, see `basic_string_buffer::short_length()`.
+    //! So when string is full this byte is zero and acts as a part of null-terminator.
+    //! All other bytes after `length()` elements are kept zero,
+    //! so short strings can be compared by whole words, see `basic_string_buffer::compare()`
+    container_type data_{};
+};
+
+//! Members are accessed directly only in constant evaluation, where short representation is always active.
+//! Otherwise active member is told by `long_flag` and bytes are loaded by `peek`, whatever member is active.
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership>
+union basic_string_buffer<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>::storage
+{
+    short_buf short_{};
+    long_buf long_;
 };
 
 } // namespace sso::detail
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <sso/detail/simd.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+//! Search kernels for strings of byte-sized characters.
+//! Sets up to `max_vector_set` characters are matched with SIMD (SSE2, AVX2 if CPU supports it),
+//! bigger sets and other platforms use 256-bit table.
+namespace sso::detail::search
+{
+
+inline constexpr std::size_t npos{ std::string_view::npos };
+
+//! Sets with more characters are searched with table, since each one costs a comparison per block
+inline constexpr std::size_t max_vector_set{ 16 };
+
+//! @return mask of `count` lowest bits
+[[nodiscard]] constexpr std::uint64_t
+low_bits(std::size_t count) noexcept
+{
+    return count >= 64 ? ~std::uint64_t{} : (std::uint64_t{ 1 } << count) - 1;
+}
+
+//! @return index of first (last if `Reverse`) set bit, `mask != 0`
+template <bool Reverse, typename Mask>
+[[nodiscard]] constexpr std::size_t
+bit_index(Mask mask) noexcept
+{
+    if constexpr (Reverse)
+    {
+        return sizeof(Mask) * CHAR_BIT - 1 - static_cast<std::size_t>(std::countl_zero(mask));
+    } else
+    {
+        return static_cast<std::size_t>(std::countr_zero(mask));
+    }
+}
+
+//! 256-bit membership table
+struct byte_set
+{
+    constexpr byte_set(byte const* set, std::size_t size) noexcept
+    {
+        for (std::size_t i{ 0 }; i < size; ++i) bits[set[i] / 64] |= std::uint64_t{ 1 } << (set[i] % 64);
+    }
+
+    [[nodiscard]] constexpr bool
+    contains(byte value) const noexcept
+    {
+        return (bits[value / 64] >> (value % 64)) & 1;
+    }
+
+    std::array<std::uint64_t, 4> bits{};
+};
+
+template <bool Reverse, bool Negate>
+[[nodiscard]] inline std::size_t
+find_of_scalar(byte const* data, std::size_t size, byte const* set, std::size_t set_size) noexcept
+{
+    byte_set const table{ set, set_size };
+    for (std::size_t i{ 0 }; i < size; ++i)
+    {
+        auto const index{ Reverse ? size - 1 - i : i };
+        if (table.contains(data[index]) != Negate) return index;
+    }
+
+    return npos;
+}
+
+//! Scans `size` bytes by blocks of `Width` bytes, `block_mask(offset)` returns matches in block.
+//! The last incomplete block is loaded overlapping already scanned bytes, which are masked out.
+//! @pre `size >= Width`
+template <bool Reverse, std::size_t Width, typename BlockMask>
+[[nodiscard]] inline std::size_t
+scan_blocks(std::size_t size, BlockMask block_mask) noexcept
+{
+    auto const full{ size - size % Width };
+    for (std::size_t i{ 0 }; i < full; i += Width)
+    {
+        auto const offset{ Reverse ? size - Width - i : i };
+        if (auto const mask{ block_mask(offset) }; mask != 0) return offset + bit_index<Reverse>(mask);
+    }
+
+    if (auto const rest{ size % Width }; rest != 0)
+    {
+        auto const offset{ Reverse ? 0 : size - Width };
+        // bits of not yet scanned bytes
+        auto const unscanned{ Reverse ? low_bits(rest) : low_bits(Width) & ~low_bits(Width - rest) };
+        if (auto const mask{ block_mask(offset) & unscanned }; mask != 0)
+        {
+            return offset + bit_index<Reverse>(static_cast<std::uint64_t>(mask));
+        }
+    }
+
+    return npos;
+}
+
+#if defined(SSO_SIMD_SSE2)
+
+//! @return bit per byte of `block`, which is equal to any of `needles`
+[[nodiscard]] inline std::uint32_t
+match_sse2(__m128i block, __m128i const* needles, std::size_t count) noexcept
+{
+    auto matches{ _mm_cmpeq_epi8(block, needles[0]) };
+    for (std::size_t i{ 1 }; i < count; ++i) matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+}
+
+//! @pre `size >= 16`, `0 < set_size <= max_vector_set`
+template <bool Reverse, bool Negate>
+[[nodiscard]] inline std::size_t
+find_of_sse2(byte const* data, std::size_t size, byte const* set, std::size_t set_size) noexcept
+{
+    __m128i needles[max_vector_set];
+    for (std::size_t i{ 0 }; i < set_size; ++i) needles[i] = _mm_set1_epi8(static_cast<char>(set[i]));
+
+    return scan_blocks<Reverse, 16>(
+        size,
+        [&](std::size_t offset) -> std::uint64_t
+        {
+            auto const block{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + offset)) };
+            auto const mask{ match_sse2(block, needles, set_size) };
+
+            return Negate ? ~mask & 0xffff : mask;
+        });
+}
+
+//! Finds `needle` by comparing its first and last characters with 16 positions at once.
+//! @pre `needle_size >= 2`, `size >= needle_size + 15`
+[[nodiscard]] inline std::size_t
+find_sse2(byte const* data, std::size_t size, byte const* needle, std::size_t needle_size) noexcept
+{
+    auto const first{ _mm_set1_epi8(static_cast<char>(needle[0])) };
+    auto const last{ _mm_set1_epi8(static_cast<char>(needle[needle_size - 1])) };
+
+    // positions, for which both loads are in bounds
+    auto const vector_end{ size - needle_size - 15 + 1 };
+    std::size_t i{ 0 };
+    for (; i < vector_end; i += 16)
+    {
+        auto const l{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i)) };
+        auto const r{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i + needle_size - 1)) };
+        auto mask{ static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(l, first), _mm_cmpeq_epi8(r, last)))) };
+        for (; mask != 0; mask &= mask - 1)
+        {
+            auto const candidate{ i + bit_index<false>(mask) };
+            if (std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+        }
+    }
+
+    std::string_view const rest{ reinterpret_cast<char const*>(data) + i, size - i };
+    auto const found{ rest.find(std::string_view{ reinterpret_cast<char const*>(needle), needle_size }) };
+
+    return found == npos ? npos : i + found;
+}
+
+//! Matches whole inline buffer at once, by overlapping 16-byte loads
+//! @return bit per byte of `block`, which is equal to any of `set`
+//! @pre `0 < set_size <= max_vector_set`
+template <std::size_t Size>
+    requires(Size >= 16 && Size <= 64)
+[[nodiscard]] inline std::uint64_t
+match_inline(std::array<std::byte, Size> const& block, byte const* set, std::size_t set_size) noexcept
+{
+    constexpr std::size_t count{ (Size + 15) / 16 };
+    // the last load overlaps previous one, if `Size` isn't multiple of 16
+    constexpr auto offset{ [](std::size_t i) { return std::min(i * 16, Size - 16); } };
+
+    __m128i blocks[count];
+    __m128i matches[count];
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        blocks[i] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block.data() + offset(i)));
+        matches[i] = _mm_setzero_si128();
+    }
+
+    // set is the outer loop, so blocks stay in registers
+    for (std::size_t j{ 0 }; j < set_size; ++j)
+    {
+        auto const needle{ _mm_set1_epi8(static_cast<char>(set[j])) };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            matches[i] = _mm_or_si128(matches[i], _mm_cmpeq_epi8(blocks[i], needle));
+        }
+    }
+
+    std::uint64_t result{ 0 };
+    for (std::size_t i{ 0 }; i < count; ++i)
+    {
+        result |= std::uint64_t{ static_cast<std::uint32_t>(_mm_movemask_epi8(matches[i])) } << offset(i);
+    }
+
+    return result;
+}
+
+#endif
+
+#if defined(SSO_SIMD_AVX2)
+
+[[gnu::target("avx2")]] [[nodiscard]] inline std::uint32_t
+match_avx2(__m256i block, __m256i const* needles, std::size_t count) noexcept
+{
+    auto matches{ _mm256_cmpeq_epi8(block, needles[0]) };
+    for (std::size_t i{ 1 }; i < count; ++i)
+    {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+    }
+
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+template <bool Negate>
+[[gnu::target("avx2")]] [[nodiscard]] inline std::uint32_t
+block_mask_avx2(byte const* block, __m256i const* needles, std::size_t count) noexcept
+{
+    auto const mask{ match_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(block)), needles, count) };
+
+    return Negate ? ~mask : mask;
+}
+
+//! Same as `find_of_sse2`, but scans 32 bytes at once.
+//! `scan_blocks` isn't reused, since lambda doesn't inherit target of enclosing function.
+//! @pre `size >= 32`, `0 < set_size <= max_vector_set`
+template <bool Reverse, bool Negate>
+[[gnu::target("avx2")]] [[nodiscard]] std::size_t
+find_of_avx2(byte const* data, std::size_t size, byte const* set, std::size_t set_size) noexcept
+{
+    __m256i needles[max_vector_set];
+    for (std::size_t i{ 0 }; i < set_size; ++i) needles[i] = _mm256_set1_epi8(static_cast<char>(set[i]));
+
+    auto const full{ size - size % 32 };
+    for (std::size_t i{ 0 }; i < full; i += 32)
+    {
+        auto const offset{ Reverse ? size - 32 - i : i };
+        if (auto const mask{ block_mask_avx2<Negate>(data + offset, needles, set_size) }; mask != 0)
+        {
+            return offset + bit_index<Reverse>(mask);
+        }
+    }
+
+    if (auto const rest{ size % 32 }; rest != 0)
+    {
+        auto const offset{ Reverse ? 0 : size - 32 };
+        auto const unscanned{ static_cast<std::uint32_t>(Reverse ? low_bits(rest) : ~low_bits(32 - rest)) };
+        auto const mask{ block_mask_avx2<Negate>(data + offset, needles, set_size) & unscanned };
+        if (mask != 0) return offset + bit_index<Reverse>(mask);
+    }
+
+    return npos;
+}
+
+//! Same as `find_sse2`, but compares 32 positions at once
+//! @pre `needle_size >= 2`, `size >= needle_size + 31`
+[[gnu::target("avx2")]] [[nodiscard]] inline std::size_t
+find_avx2(byte const* data, std::size_t size, byte const* needle, std::size_t needle_size) noexcept
+{
+    auto const first{ _mm256_set1_epi8(static_cast<char>(needle[0])) };
+    auto const last{ _mm256_set1_epi8(static_cast<char>(needle[needle_size - 1])) };
+
+    auto const vector_end{ size - needle_size - 31 + 1 };
+    std::size_t i{ 0 };
+    for (; i < vector_end; i += 32)
+    {
+        auto const l{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i)) };
+        auto const r{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + needle_size - 1)) };
+        auto mask{ static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(l, first), _mm256_cmpeq_epi8(r, last)))) };
+        for (; mask != 0; mask &= mask - 1)
+        {
+            auto const candidate{ i + bit_index<false>(mask) };
+            if (std::memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0) return candidate;
+        }
+    }
+
+    std::string_view const rest{ reinterpret_cast<char const*>(data) + i, size - i };
+    auto const found{ rest.find(std::string_view{ reinterpret_cast<char const*>(needle), needle_size }) };
+
+    return found == npos ? npos : i + found;
+}
+
+#endif
+
+//! @return index of first (last if `Reverse`) byte, which is in `set` (isn't if `Negate`), or `npos`
+template <bool Reverse, bool Negate>
+[[nodiscard]] inline std::size_t
+find_of(byte const* data, std::size_t size, byte const* set, std::size_t set_size) noexcept
+{
+    if (set_size == 0) return !Negate || size == 0 ? npos : (Reverse ? size - 1 : 0);
+
+    if (set_size <= max_vector_set)
+    {
+#if defined(SSO_SIMD_AVX2)
+        if (size >= 32 && has_avx2()) return find_of_avx2<Reverse, Negate>(data, size, set, set_size);
+#endif
+#if defined(SSO_SIMD_SSE2)
+        if (size >= 16) return find_of_sse2<Reverse, Negate>(data, size, set, set_size);
+#endif
+    }
+
+    return find_of_scalar<Reverse, Negate>(data, size, set, set_size);
+}
+
+//! @return index of first occurrence of `needle`, or `npos`
+[[nodiscard]] inline std::size_t
+find(byte const* data, std::size_t size, byte const* needle, std::size_t needle_size) noexcept
+{
+    if (needle_size == 0) return 0;
+    if (needle_size > size) return npos;
+    if (needle_size == 1)
+    {
+        auto const* const found{ static_cast<byte const*>(std::memchr(data, needle[0], size)) };
+
+        return found == nullptr ? npos : static_cast<std::size_t>(found - data);
+    }
+
+#if defined(SSO_SIMD_AVX2)
+    if (size >= needle_size + 31 && has_avx2()) return find_avx2(data, size, needle, needle_size);
+#endif
+#if defined(SSO_SIMD_SSE2)
+    if (size >= needle_size + 15) return find_sse2(data, size, needle, needle_size);
+#endif
+
+    return std::string_view{ reinterpret_cast<char const*>(data), size }.find(
+        std::string_view{ reinterpret_cast<char const*>(needle), needle_size });
+}
+
+//! Whether inline buffer of `Size` bytes is searched by `find_of_inline`
+template <std::size_t Size>
+inline constexpr bool inline_search{
+#if defined(SSO_SIMD_SSE2)
+    Size >= 16 && Size <= 64
+#else
+    false
+#endif
+};
+
+//! Searches inline buffer `block` without loop over its characters.
+//! Bytes past the string are matched too, so result is masked by [ `first`, `last` ).
+//! @return index of first (last if `Reverse`) byte within range, which is in `set` (isn't if `Negate`), or `npos`
+//! @pre `inline_search<Size>`, `0 < set_size <= max_vector_set`, `first <= last <= Size`
+template <bool Reverse, bool Negate, std::size_t Size>
+[[nodiscard]] inline std::size_t
+find_of_inline(std::array<std::byte, Size> const& block, std::size_t first, std::size_t last, byte const* set,
+               std::size_t set_size) noexcept
+{
+#if defined(SSO_SIMD_SSE2)
+    auto const matches{ match_inline(block, set, set_size) };
+#else
+    std::uint64_t matches{ 0 };
+    byte_set const table{ set, set_size };
+    for (std::size_t i{ 0 }; i < std::min(Size, std::size_t{ 64 }); ++i)
+    {
+        matches |= std::uint64_t{ table.contains(static_cast<byte>(block[i])) } << i;
+    }
+#endif
+
+    auto const range{ low_bits(last) & ~low_bits(first) };
+    auto const mask{ (Negate ? ~matches : matches) & range };
+
+    return mask == 0 ? npos : bit_index<Reverse>(mask);
+}
+
+} // namespace sso::detail::search
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <concepts>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSO_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 kernels are compiled for target "avx2" and chosen at runtime, unless AVX2 is enabled globally
+#if defined(SSO_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define SSO_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace sso::detail
+{
+
+//! Characters, which are processed by byte-wise kernels
+template <typename Char>
+concept byte_char = std::integral<Char> && sizeof(Char) == 1;
+
+using byte = unsigned char;
+
+template <byte_char Char>
+[[nodiscard]] inline byte const*
+bytes(Char const* data) noexcept
+{
+    return reinterpret_cast<byte const*>(data);
+}
+
+template <byte_char Char>
+[[nodiscard]] inline byte*
+bytes(Char* data) noexcept
+{
+    return reinterpret_cast<byte*>(data);
+}
+
+#if defined(SSO_SIMD_AVX2)
+
+//! @return `true` if kernels compiled with `[[gnu::target("avx2")]]` can be called
+[[nodiscard]] inline bool
+has_avx2() noexcept
+{
+#if defined(__AVX2__)
+    return true;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+} // namespace sso::detail
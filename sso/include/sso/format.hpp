@@ -0,0 +1,100 @@
+#pragma once
+
+#include <sso/growth_policy.hpp>
+#include <sso/ownership_policy.hpp>
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <iterator>
+#include <utility>
+
+namespace sso
+{
+
+//! Appends formatted `args` to `out` without temporary string.
+//! Characters are written directly into spare capacity of `out` (inline buffer of short string),
+//! so message, which fits, is formatted without allocation. Otherwise `out` grows according to
+//! its `GrowthPolicy` and formatting is repeated once.
+//! @return `out`
+//! @throws whatever formatters of `args` throw, `out` then has its old characters (capacity may be grown)
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership, typename... Args>
+basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>&
+format_to(basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>& out,
+          std::basic_format_string<std::type_identity_t<Char>, std::type_identity_t<Args>...> fmt, Args&&... args)
+{
+    auto const size{ out.size() };
+    auto const spare{ out.capacity() - size };
+
+    // operation of `resize_and_overwrite` must not throw, so exception of formatter is caught,
+    // old characters are kept and the exception is rethrown after `out` is consistent again
+    std::exception_ptr error;
+    auto const overwrite{ [&](std::size_t capacity, auto write)
+                          {
+                              out.resize_and_overwrite(capacity,
+                                                       [&](Char* data, std::size_t count) -> std::size_t
+                                                       {
+                                                           try
+                                                           {
+                                                               return write(data, count);
+                                                           }
+                                                           catch (...)
+                                                           {
+                                                               error = std::current_exception();
+                                                               return size;
+                                                           }
+                                                       });
+                              if (error) std::rethrow_exception(error);
+                          } };
+
+    // arguments are only bound to references by `format_to_n`/`format_to`, so they can be forwarded twice
+    std::size_t formatted_size{ 0 };
+    overwrite(out.capacity(),
+              [&](Char* data, std::size_t)
+              {
+                  auto const result{ std::format_to_n(data + size, static_cast<std::ptrdiff_t>(spare), fmt,
+                                                      std::forward<Args>(args)...) };
+                  formatted_size = static_cast<std::size_t>(result.size);
+
+                  return size + std::min(formatted_size, spare);
+              });
+
+    if (formatted_size > spare)
+    {
+        overwrite(size + formatted_size,
+                  [&](Char* data, std::size_t count)
+                  {
+                      std::format_to(data + size, fmt, std::forward<Args>(args)...);
+
+                      return count;
+                  });
+    }
+
+    return out;
+}
+
+//! Like `std::format`, but result is `sso::string`, so short message doesn't allocate
+template <typename... Args>
+[[nodiscard]] string
+format(std::format_string<Args...> fmt, Args&&... args)
+{
+    string result;
+    sso::format_to(result, fmt, std::forward<Args>(args)...);
+
+    return result;
+}
+
+template <typename... Args>
+[[nodiscard]] basic_string<wchar_t>
+format(std::wformat_string<Args...> fmt, Args&&... args)
+{
+    basic_string<wchar_t> result;
+    sso::format_to(result, fmt, std::forward<Args>(args)...);
+
+    return result;
+}
+
+} // namespace sso
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+
+namespace sso
+{
+
+//! Policy, which decides how much memory string allocate when it runs out of capacity.
+//! `T::grow(capacity, required)` returns new capacity (excluding null-terminator),
+//! result less than `required` is ignored.
+template <typename T>
+concept growth_policy = requires(std::size_t capacity, std::size_t required) {
+    { T::grow(capacity, required) } -> std::convertible_to<std::size_t>;
+};
+
+//! Doubles capacity, so sequence of `push_back`/`append` takes amortized O(1) per element.
+struct geometric_growth
+{
+    //! @pre `capacity < required`
+    [[nodiscard]] static constexpr std::size_t
+    grow(std::size_t capacity, std::size_t required) noexcept
+    {
+        return std::max(capacity * 2, required);
+    }
+};
+
+//! Allocates exactly as much as needed. Minimizes memory usage, but repeated appends are O(n) each.
+struct exact_growth
+{
+    //! @pre `capacity < required`
+    [[nodiscard]] static constexpr std::size_t
+    grow(std::size_t /* capacity */, std::size_t required) noexcept
+    {
+        return required;
+    }
+};
+
+} // namespace sso
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <sso/growth_policy.hpp>
+#include <sso/ownership_policy.hpp>
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace sso
+{
+
+namespace detail
+{
+
+// wyhash constants
+inline constexpr std::uint64_t hash_secret[]{ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                              0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+//! Strings with less bytes are hashed as 3 words padded with zeroes
+inline constexpr std::size_t small_hash_bytes{ 3 * sizeof(std::uint64_t) };
+
+//! @return xor of high and low halves of 128-bit product
+[[nodiscard]] inline std::uint64_t
+hash_mix(std::uint64_t l, std::uint64_t r) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128 = unsigned __int128;
+
+    auto const product{ static_cast<uint128>(l) * r };
+
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+    auto const l_lo{ l & 0xffffffff }, l_hi{ l >> 32 };
+    auto const r_lo{ r & 0xffffffff }, r_hi{ r >> 32 };
+    auto const lo_lo{ l_lo * r_lo }, hi_lo{ l_hi * r_lo }, lo_hi{ l_lo * r_hi }, hi_hi{ l_hi * r_hi };
+    auto const cross{ (lo_lo >> 32) + (hi_lo & 0xffffffff) + (lo_hi & 0xffffffff) };
+
+    auto const low{ (cross << 32) | (lo_lo & 0xffffffff) };
+    auto const high{ hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (cross >> 32) };
+
+    return low ^ high;
+#endif
+}
+
+[[nodiscard]] inline std::uint64_t
+load_word(std::byte const* p) noexcept
+{
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+
+    return word;
+}
+
+//! @return mask, which keeps first `bytes` bytes (in memory order) of word
+//! @pre `bytes <= sizeof(std::uint64_t)`
+[[nodiscard]] constexpr std::uint64_t
+prefix_mask(std::size_t bytes) noexcept
+{
+    // shift in two steps, because shift by word width is UB
+    auto const half_shift{ bytes * CHAR_BIT / 2 };
+
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        return ~((~std::uint64_t{} << half_shift) << half_shift);
+    } else
+    {
+        return ~((~std::uint64_t{} >> half_shift) >> half_shift);
+    }
+}
+
+//! @pre `size < small_hash_bytes`
+//! @pre `words` points to `small_hash_bytes` readable bytes, first `size` of them are string,
+//!      following bytes are unspecified
+//! @param fold is applied to each loaded word, it must map bytes independently and keep zero bytes
+//!        (e.g. case folding)
+template <typename Fold = std::identity>
+[[nodiscard]] inline std::uint64_t
+hash_small(std::byte const* words, std::size_t size, Fold fold = {}) noexcept
+{
+    auto const word{ [&](std::size_t i)
+                     {
+                         auto const offset{ i * sizeof(std::uint64_t) };
+                         // signed clamp compiles to `cmov`, unsigned saturation - to jumps
+                         auto const rest{ static_cast<std::ptrdiff_t>(size) - static_cast<std::ptrdiff_t>(offset) };
+                         auto const bytes{ std::clamp<std::ptrdiff_t>(rest, 0, sizeof(std::uint64_t)) };
+
+                         return fold(load_word(words + offset) & prefix_mask(static_cast<std::size_t>(bytes)));
+                     } };
+
+    auto const seed{ hash_mix(word(0) ^ hash_secret[1], word(1) ^ hash_secret[0] ^ size) };
+
+    return hash_mix(seed ^ word(2) ^ hash_secret[2], hash_secret[3] ^ size);
+}
+
+//! @pre `size >= small_hash_bytes`
+template <typename Fold = std::identity>
+[[nodiscard]] inline std::uint64_t
+hash_large(std::byte const* data, std::size_t size, Fold fold = {}) noexcept
+{
+    std::uint64_t seed{ hash_secret[0] };
+
+    auto const* p{ data };
+    for (auto rest{ size }; rest > 16; rest -= 16, p += 16)
+    {
+        seed = hash_mix(fold(load_word(p)) ^ hash_secret[1], fold(load_word(p + 8)) ^ seed);
+    }
+
+    auto const* const last{ data + size };
+    seed = hash_mix(fold(load_word(last - 16)) ^ hash_secret[1], fold(load_word(last - 8)) ^ seed);
+
+    return hash_mix(seed ^ hash_secret[2], hash_secret[3] ^ size);
+}
+
+template <typename Fold = std::identity>
+[[nodiscard]] inline std::uint64_t
+hash_bytes(std::byte const* data, std::size_t size, Fold fold = {}) noexcept
+{
+    if (size >= small_hash_bytes) return hash_large(data, size, fold);
+
+    std::array<std::byte, small_hash_bytes> words{};
+    if (size != 0) std::memcpy(words.data(), data, size);
+
+    return hash_small(words.data(), size, fold);
+}
+
+} // namespace detail
+
+//! Fast non-cryptographic transparent hasher in the spirit of wyhash.
+//! Strings shorter than 24 bytes are read as 3 words at once, directly from inline buffer if possible.
+//! Result isn't the same as of `std::hash`, but is the same for `basic_string`, `string_view` and
+//! `Char const*` with equal content, so it can be used for heterogeneous lookup.
+template <typename Char>
+struct basic_fast_hash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t
+    operator()(std::basic_string_view<Char> str) const noexcept
+    {
+        return static_cast<std::size_t>(
+            detail::hash_bytes(reinterpret_cast<std::byte const*>(str.data()), str.size() * sizeof(Char)));
+    }
+
+    [[nodiscard]] std::size_t
+    operator()(Char const* str) const noexcept
+    {
+        return (*this)(std::basic_string_view<Char>{ str });
+    }
+
+    template <typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+              ownership_policy Ownership>
+    [[nodiscard]] std::size_t
+    operator()(basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& str) const noexcept
+    {
+        auto const& buffer{ str.buffer };
+        auto const& representation{ buffer.representation() };
+        static_assert(sizeof(representation) >= detail::small_hash_bytes);
+
+        if (auto const size{ buffer.length() * sizeof(Char) };
+            buffer.is_inline() && size < detail::small_hash_bytes)
+        {
+            return static_cast<std::size_t>(detail::hash_small(representation.data(), size));
+        }
+
+        return (*this)(static_cast<std::basic_string_view<Char>>(str));
+    }
+};
+
+using fast_hash = basic_fast_hash<char>;
+
+} // namespace sso
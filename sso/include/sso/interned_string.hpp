@@ -0,0 +1,388 @@
+#pragma once
+
+#include <sso/hash.hpp>
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace sso
+{
+
+template <typename Char, typename Mutex, std::size_t Shards>
+struct basic_intern_pool;
+
+namespace detail
+{
+
+//! Header of long interned string, characters and null-terminator follow it in the pool's arena
+template <typename Char>
+struct intern_entry
+{
+    std::size_t hash;
+    std::size_t length;
+    void const* pool;
+
+    [[nodiscard]] Char const*
+    data() const noexcept
+    {
+        return reinterpret_cast<Char const*>(this + 1);
+    }
+
+    [[nodiscard]] std::basic_string_view<Char>
+    view() const noexcept
+    {
+        return { data(), length };
+    }
+};
+
+} // namespace detail
+
+//! Immutable string, which is either stored inline (as short `basic_string`),
+//! or references deduplicated characters in `basic_intern_pool`.
+//! So equality of long strings from the same pool is a pointer comparison
+//! and their hash is computed once, when they are interned.
+//! @note Long strings must not outlive their pool, see `basic_intern_pool::release()`
+template <typename Char>
+struct basic_interned_string
+{
+private:
+    using string_type = basic_string<Char>;
+    using entry_type = detail::intern_entry<Char>;
+
+public:
+    using size_type = std::size_t;
+    using value_type = Char;
+    using const_pointer = Char const*;
+    using string_view = std::basic_string_view<Char>;
+
+    //! @post `empty()`
+    constexpr basic_interned_string() noexcept = default;
+
+    //! Copy is cheap and leaves `other` intact, so there is no separate move
+    constexpr basic_interned_string(basic_interned_string const& other) = default;
+
+    constexpr basic_interned_string&
+    operator=(basic_interned_string const& other) = default;
+
+    //! @return maximal length of string, which is stored inline instead of pool
+    [[nodiscard]] static constexpr size_type
+    inline_capacity() noexcept
+    {
+        return string_type::inline_capacity();
+    }
+
+    [[nodiscard]] constexpr bool
+    is_inline() const noexcept
+    {
+        return entry_ == nullptr;
+    }
+
+    [[nodiscard]] constexpr size_type
+    size() const noexcept
+    {
+        return is_inline() ? inline_.size() : entry_->length;
+    }
+
+    [[nodiscard]] constexpr size_type
+    length() const noexcept
+    {
+        return size();
+    }
+
+    [[nodiscard]] constexpr bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    //! @return null-terminated array [ `data()`, `data() + size()` ]
+    [[nodiscard]] constexpr const_pointer
+    data() const noexcept
+    {
+        return is_inline() ? inline_.data() : entry_->data();
+    }
+
+    [[nodiscard]] constexpr const_pointer
+    c_str() const noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] constexpr string_view
+    view() const noexcept
+    {
+        return is_inline() ? static_cast<string_view>(inline_) : entry_->view();
+    }
+
+    [[nodiscard]] constexpr
+    operator string_view() const noexcept
+    {
+        return view();
+    }
+
+    //! Complexity: O(1), hash of long string is cached in the pool
+    //! @return the same value as `basic_fast_hash<Char>` of content
+    [[nodiscard]] std::size_t
+    hash() const noexcept
+    {
+        return is_inline() ? basic_fast_hash<Char>{}(inline_) : entry_->hash;
+    }
+
+    //! Short strings are compared by words, long strings from the same pool - by pointers
+    [[nodiscard]] friend constexpr bool
+    operator==(basic_interned_string const& l, basic_interned_string const& r) noexcept
+    {
+        if (l.entry_ == r.entry_) return l.inline_ == r.inline_;
+
+        // the same pool never holds two entries with equal content
+        return !l.is_inline() && !r.is_inline() && l.entry_->pool != r.entry_->pool
+               && l.entry_->view() == r.entry_->view();
+    }
+
+    [[nodiscard]] friend constexpr bool
+    operator==(basic_interned_string const& l, string_view r) noexcept
+    {
+        return l.view() == r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_interned_string const& l, basic_interned_string const& r) noexcept
+    {
+        return l.view() <=> r.view();
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_interned_string const& l, string_view r) noexcept
+    {
+        return l.view() <=> r;
+    }
+
+private:
+    template <typename, typename, std::size_t>
+    friend struct basic_intern_pool;
+
+    //! @pre `value.size() <= inline_capacity()`
+    explicit constexpr basic_interned_string(string_view value)
+        : inline_{ value }
+    {
+    }
+
+    explicit constexpr basic_interned_string(entry_type const* entry) noexcept
+        : entry_{ entry }
+    {
+    }
+
+    //! `nullptr` if string is inline
+    entry_type const* entry_{ nullptr };
+    //! Empty if string isn't inline, so it never allocates
+    string_type inline_;
+};
+
+//! Entry pointer doesn't depend on address of the string, see `basic_string`
+template <typename Char>
+struct is_trivially_relocatable<basic_interned_string<Char>> : is_trivially_relocatable<basic_string<Char>>
+{
+};
+
+using interned_string = basic_interned_string<char>;
+
+//! Satisfies `BasicLockable` without any synchronization, see `arena_intern_pool`
+struct null_mutex
+{
+    constexpr void
+    lock() noexcept
+    {
+    }
+
+    constexpr void
+    unlock() noexcept
+    {
+    }
+};
+
+//! Deduplicates long strings. Characters of each one are stored once in arena
+//! and released all together in `release()` or destructor.
+//! @tparam Mutex guards each shard, `null_mutex` makes pool single-threaded
+//! @tparam Shards number of independently locked parts, strings are distributed by hash
+template <typename Char, typename Mutex = std::mutex, std::size_t Shards = 16>
+struct basic_intern_pool
+{
+    static_assert(Shards > 0);
+
+    using interned_string = basic_interned_string<Char>;
+    using string_view = std::basic_string_view<Char>;
+
+    basic_intern_pool() = default;
+    basic_intern_pool(basic_intern_pool const&) = delete;
+    basic_intern_pool&
+    operator=(basic_intern_pool const&) = delete;
+
+    //! Short `value` is stored inline without touching the pool.
+    //! Long `value` is copied into the pool, unless equal one is already there.
+    //! Complexity: O(`value.size()`)
+    [[nodiscard]] interned_string
+    intern(string_view value)
+    {
+        if (value.size() <= interned_string::inline_capacity()) return interned_string{ value };
+
+        auto const hash{ basic_fast_hash<Char>{}(value) };
+        auto& shard{ shards_[shard_index(hash)] };
+
+        std::scoped_lock const lock{ shard.mutex };
+        if (auto const it{ shard.entries.find(key{ value, hash }) }; it != shard.entries.end())
+        {
+            return interned_string{ *it };
+        }
+
+        auto const* const entry{ make_entry(shard.arena, value, hash) };
+        shard.entries.insert(entry);
+
+        return interned_string{ entry };
+    }
+
+    //! @return number of long strings in the pool
+    [[nodiscard]] std::size_t
+    size()
+    {
+        std::size_t result{ 0 };
+        for (auto& shard : shards_)
+        {
+            std::scoped_lock const lock{ shard.mutex };
+            result += shard.entries.size();
+        }
+
+        return result;
+    }
+
+    //! Releases all long strings at once.
+    //! @pre long strings interned by `*this` aren't used afterwards
+    void
+    release()
+    {
+        for (auto& shard : shards_)
+        {
+            std::scoped_lock const lock{ shard.mutex };
+            shard.entries.clear();
+            shard.arena.release();
+        }
+    }
+
+private:
+    using entry_type = detail::intern_entry<Char>;
+
+    struct key
+    {
+        string_view value;
+        std::size_t hash;
+    };
+
+    struct entry_hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t
+        operator()(entry_type const* entry) const noexcept
+        {
+            return entry->hash;
+        }
+
+        [[nodiscard]] std::size_t
+        operator()(key const& key) const noexcept
+        {
+            return key.hash;
+        }
+    };
+
+    struct entry_equal
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] bool
+        operator()(entry_type const* l, entry_type const* r) const noexcept
+        {
+            return l == r;
+        }
+
+        [[nodiscard]] bool
+        operator()(key const& l, entry_type const* r) const noexcept
+        {
+            return l.hash == r->hash && l.value == r->view();
+        }
+
+        [[nodiscard]] bool
+        operator()(entry_type const* l, key const& r) const noexcept
+        {
+            return (*this)(r, l);
+        }
+    };
+
+    struct shard
+    {
+        Mutex mutex;
+        std::pmr::monotonic_buffer_resource arena;
+        std::unordered_set<entry_type const*, entry_hash, entry_equal> entries;
+    };
+
+    //! Uses high bits, because low bits choose bucket inside shard
+    [[nodiscard]] static constexpr std::size_t
+    shard_index(std::size_t hash) noexcept
+    {
+        return (hash >> (sizeof(hash) * CHAR_BIT / 2)) % Shards;
+    }
+
+    //! @return entry followed by copy of `value` and null-terminator, allocated in `arena`
+    [[nodiscard]] entry_type const*
+    make_entry(std::pmr::memory_resource& arena, string_view value, std::size_t hash) const
+    {
+        auto* const memory{ arena.allocate(sizeof(entry_type) + (value.size() + 1) * sizeof(Char),
+                                           alignof(entry_type)) };
+        auto* const entry{ std::construct_at(static_cast<entry_type*>(memory),
+                                             entry_type{ hash, value.size(), this }) };
+
+        auto* const data{ const_cast<Char*>(entry->data()) };
+        std::ranges::copy(value, data);
+        data[value.size()] = Char{};
+
+        return entry;
+    }
+
+    std::array<shard, Shards> shards_;
+};
+
+//! Thread-safe pool with sharded locking
+using intern_pool = basic_intern_pool<char>;
+
+//! Single-threaded pool, which doesn't lock at all
+using arena_intern_pool = basic_intern_pool<char, null_mutex, 1>;
+
+//! @return process-wide thread-safe pool, which lives until program exit
+[[nodiscard]] inline intern_pool&
+global_intern_pool()
+{
+    static intern_pool pool;
+
+    return pool;
+}
+
+} // namespace sso
+
+template <typename Char>
+struct std::hash<sso::basic_interned_string<Char>>
+{
+    //! Complexity: O(1), see `sso::basic_interned_string::hash()`
+    [[nodiscard]] std::size_t
+    operator()(sso::basic_interned_string<Char> const& str) const noexcept
+    {
+        return str.hash();
+    }
+};
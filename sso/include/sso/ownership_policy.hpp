@@ -0,0 +1,33 @@
+#pragma once
+
+#include <concepts>
+
+namespace sso
+{
+
+//! Policy, which decides whether copies of long string share its heap buffer.
+//! Short strings are always stored inline and copied.
+template <typename T>
+concept ownership_policy = requires {
+    { T::shared } -> std::convertible_to<bool>;
+};
+
+//! Every string owns its heap buffer, so copy allocates and copies characters.
+struct unique_ownership
+{
+    static constexpr bool shared{ false };
+};
+
+//! Copy of long string shares heap buffer, so it takes O(1) (copy-on-write).
+//! Heap buffer starts with atomic reference counter, so copies can be used from different threads.
+//! Shared buffer is copied on first mutable access (non-const `data()`, `begin()`, `operator[]`,
+//! `replace`, ...), which therefore can throw and invalidates pointers obtained from const access.
+//! Non-const `data()`, `begin()`, `operator[]`, ... also make buffer unshareable: later copies allocate,
+//! so writes through references obtained before the copy don't change it. It ends when buffer is reallocated.
+//! The same way string can refer to static storage without allocation, see `sso::static_storage`.
+struct shared_ownership
+{
+    static constexpr bool shared{ true };
+};
+
+} // namespace sso
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//! Lets clang pass strings in registers and relocate them by bytes (it treats such types as trivially relocatable).
+//! Define it empty before including `sso` headers to keep the usual ABI,
+//! e.g. if allocator isn't trivially copyable and clang warns that attribute is ignored
+#if !defined(SSO_TRIVIAL_ABI)
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::trivial_abi)
+#define SSO_TRIVIAL_ABI [[clang::trivial_abi]]
+#endif
+#endif
+#endif
+#if !defined(SSO_TRIVIAL_ABI)
+#define SSO_TRIVIAL_ABI
+#endif
+
+//! Relocation is move to another address followed by destruction of source (P1144).
+//! For most types, including `sso::basic_string`, it is the same as copying bytes,
+//! so containers can move elements by single `memcpy` when they grow.
+namespace sso
+{
+
+//! Whether objects of `T` can be relocated by copying bytes, without calling move constructor and destructor.
+//! Specialize it for types, which don't store pointers to themselves
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+//! Stateless, though its copy constructor is user-provided in some implementations
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v{ is_trivially_relocatable<T>::value };
+
+//! Moves `[first, last)` to uninitialized memory at `out` and ends lifetime of source objects.
+//! Trivially relocatable objects are copied by single `memcpy`.
+//! If move constructor throws, both source and already relocated objects are destroyed
+//! @pre ranges don't overlap
+//! @return end of relocated range
+template <typename T>
+T*
+uninitialized_relocate(T* first, T* last, T* out) noexcept(is_trivially_relocatable_v<T>
+                                                             || std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        auto const count{ static_cast<std::size_t>(last - first) };
+        if (count != 0) std::memcpy(static_cast<void*>(out), static_cast<void const*>(first), count * sizeof(T));
+
+        return out + count;
+    } else
+    {
+        auto* const out_first{ out };
+        auto const relocate{ [&]
+                             {
+                                 for (; first != last; ++first, ++out)
+                                 {
+                                     std::construct_at(out, std::move(*first));
+                                     std::destroy_at(first);
+                                 }
+                             } };
+
+        if constexpr (std::is_nothrow_move_constructible_v<T>)
+        {
+            relocate();
+        } else
+        {
+            try
+            {
+                relocate();
+            } catch (...)
+            {
+                std::destroy(first, last);
+                std::destroy(out_first, out);
+                throw;
+            }
+        }
+
+        return out;
+    }
+}
+
+//! Relocates single object from `source` to uninitialized memory at `out`, see `uninitialized_relocate`
+//! @return `out`
+template <typename T>
+T*
+relocate_at(T* source, T* out) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    uninitialized_relocate(source, source + 1, out);
+
+    return out;
+}
+
+} // namespace sso
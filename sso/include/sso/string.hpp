@@ -1,24 +1,59 @@
 #pragma once
 
 #include <sso/detail/basic_string_buffer.hpp>
+#include <sso/detail/search.hpp>
+#include <sso/growth_policy.hpp>
+#include <sso/ownership_policy.hpp>
+#include <sso/relocate.hpp>
 #include <sso/util.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <format>
+#include <functional>
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <version>
 
 namespace sso
 {
 
-template <typename Char, typename Allocator = std::allocator<Char>>
-struct basic_string
+template <typename Char>
+struct basic_fast_hash;
+
+template <typename Char>
+struct basic_case_insensitive_hash;
+
+template <typename Char>
+struct basic_case_insensitive_equal;
+
+template <typename Char>
+struct basic_case_insensitive_compare;
+
+//! Tag of constructor, which refers to characters in static storage instead of copying them
+struct static_storage_t
+{
+    explicit static_storage_t() = default;
+};
+
+inline constexpr static_storage_t static_storage{};
+
+//! @tparam InlineCapacity minimal number of characters stored without allocation.
+//!         By default as many as fit into the size of heap representation (23 `char`s),
+//!         larger values increase `sizeof(basic_string)`, see `inline_capacity()`
+//! @tparam Ownership `shared_ownership` makes copies of long strings O(1) (copy-on-write)
+template <typename Char, typename Allocator = std::allocator<Char>,
+          growth_policy GrowthPolicy = geometric_growth, std::size_t InlineCapacity = 0,
+          ownership_policy Ownership = unique_ownership>
+struct SSO_TRIVIAL_ABI basic_string
 {
 private:
-    using basic_string_buffer = detail::basic_string_buffer<Char, Allocator>;
+    using basic_string_buffer
+        = detail::basic_string_buffer<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>;
     using allocator_traits = std::allocator_traits<typename basic_string_buffer::allocator_type>;
 
 public:
@@ -35,11 +70,13 @@ public:
 
     using string_view = std::basic_string_view<Char>;
 
+    //! O(1) for long strings if `Ownership` is `shared_ownership`
     constexpr basic_string(basic_string const& other)
-        : basic_string{ static_cast<string_view>(other) }
+        : buffer{ other.buffer }
     {
     }
 
+    //! @post `other.empty()`
     constexpr basic_string(basic_string&& other) noexcept
         : buffer{ static_cast<basic_string_buffer&&>(other.buffer) }
     {
@@ -55,22 +92,40 @@ public:
     {
     }
 
-    explicit constexpr basic_string(string_view other)
-        : buffer{ other }
+    explicit constexpr basic_string(string_view other, allocator_type const& allocator = allocator_type())
+        : buffer{ other, allocator }
     {
     }
 
-    explicit constexpr basic_string(value_type const* c_str)
-        : basic_string{ string_view(c_str) }
+    explicit constexpr basic_string(value_type const* c_str, allocator_type const& allocator = allocator_type())
+        : basic_string{ string_view(c_str), allocator }
     {
     }
 
+    //! Refers to long `str` without allocation, it is copied on first mutable access like shared heap buffer,
+    //! copies of `*this` refer to the same storage. Short `str` is copied into inline buffer as usual
+    //! @pre `str` lives until the end of program (e.g. string literal) and is followed by null-terminator
+    constexpr basic_string(static_storage_t, string_view str, allocator_type const& allocator = allocator_type())
+        requires Ownership::shared
+        : buffer{ allocator }
+    {
+        buffer.borrow(str);
+    }
+
     constexpr basic_string&
-    operator=(basic_string other)
+    operator=(basic_string const& other)
     {
-        using std::swap;
+        buffer = other.buffer;
+
+        return *this;
+    }
 
-        swap(*this, other);
+    //! @post `other.empty()`
+    constexpr basic_string&
+    operator=(basic_string&& other) noexcept(
+        std::is_nothrow_move_assignable_v<basic_string_buffer>)
+    {
+        buffer = std::move(other.buffer);
 
         return *this;
     }
@@ -102,6 +157,13 @@ public:
         return buffer.capacity();
     }
 
+    //! @return maximal length of string, which is stored without allocation, `>= InlineCapacity`
+    [[nodiscard]] static constexpr size_type
+    inline_capacity() noexcept
+    {
+        return basic_string_buffer::inline_capacity();
+    }
+
     [[nodiscard]] constexpr size_type
     size() const noexcept
     {
@@ -122,8 +184,9 @@ public:
     }
 
     //! @return [ `data()`, `data() + size()` ).
+    //!         Copies shared heap buffer, see `shared_ownership`
     [[nodiscard]] constexpr pointer
-    data() noexcept
+    data() noexcept(!Ownership::shared)
     {
         return buffer.data();
     }
@@ -139,7 +202,7 @@ public:
 
     //! @pre `position < size()`
     [[nodiscard]] constexpr reference
-    operator[](size_type position) noexcept
+    operator[](size_type position) noexcept(!Ownership::shared)
     {
         assert(position < size());
 
@@ -155,7 +218,7 @@ public:
     [[nodiscard]] friend constexpr bool
     operator==(basic_string const& l, basic_string const& r) noexcept
     {
-        return std::ranges::equal(l, r);
+        return l.buffer.equals(r.buffer);
     }
 
     [[nodiscard]] friend constexpr bool
@@ -164,8 +227,15 @@ public:
         return static_cast<string_view>(l) == r;
     }
 
+    [[nodiscard]] friend constexpr bool
+    operator==(basic_string const& l, value_type const* r) noexcept
+    {
+        return static_cast<string_view>(l) == string_view{ r };
+    }
+
+    //! Exchanges allocators only if `propagate_on_container_swap`, see `basic_string_buffer`
     friend constexpr void
-    swap(basic_string& l, basic_string& r) noexcept
+    swap(basic_string& l, basic_string& r) noexcept(std::is_nothrow_swappable_v<basic_string_buffer>)
     {
         using std::swap;
 
@@ -192,7 +262,7 @@ public:
 
     //! @pre `!empty()`
     [[nodiscard]] constexpr reference
-    front() noexcept
+    front() noexcept(!Ownership::shared)
     {
         assert(!empty());
 
@@ -201,7 +271,7 @@ public:
 
     //! @pre `!empty()`
     [[nodiscard]] constexpr reference
-    back() noexcept
+    back() noexcept(!Ownership::shared)
     {
         assert(!empty());
 
@@ -218,7 +288,7 @@ public:
     constexpr void
     clear() noexcept
     {
-        replace(0, size(), string_view{});
+        buffer.clear();
     }
 
     //! @throws `std::out_of_range` if `position >= size()`
@@ -257,6 +327,19 @@ public:
         return buffer.end();
     }
 
+    //! Unlike non-const `begin()` doesn't copy shared heap buffer
+    [[nodiscard]] constexpr const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    [[nodiscard]] constexpr const_iterator
+    cend() const
+    {
+        return end();
+    }
+
     //! @throws `std::length_error` if `count > max_size()`
     constexpr void
     reserve(size_type size)
@@ -294,10 +377,10 @@ public:
     constexpr iterator
     erase(const_iterator pos)
     {
-        assert(begin() <= pos);
-        assert(pos < end());
+        assert(cbegin() <= pos);
+        assert(pos < cend());
 
-        difference_type const i{ pos - begin() };
+        difference_type const i{ pos - cbegin() };
         replace(i, 1, string_view{});
 
         return begin() + i;
@@ -309,13 +392,13 @@ public:
     constexpr iterator
     erase(const_iterator first, const_iterator last)
     {
-        assert(begin() <= first);
-        assert(first <= end());
-        assert(begin() <= last);
-        assert(last <= end());
+        assert(cbegin() <= first);
+        assert(first <= cend());
+        assert(cbegin() <= last);
+        assert(last <= cend());
         assert(first <= last);
 
-        difference_type const pos{ first - begin() };
+        difference_type const pos{ first - cbegin() };
         difference_type const size{ last - first };
         replace(pos, size, string_view{});
 
@@ -326,19 +409,72 @@ public:
     constexpr basic_string&
     insert(const_iterator pos, string_view str)
     {
-        assert(begin() <= pos);
-        assert(pos <= end());
+        assert(cbegin() <= pos);
+        assert(pos <= cend());
 
-        difference_type const i{ pos - begin() };
+        difference_type const i{ pos - cbegin() };
         replace(i, 0, str);
 
         return *this;
     }
 
-    friend constexpr basic_string
-    operator+(basic_string l, string_view r)
+    //! Allocates result at once
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string const& l, string_view r)
+    {
+        return concat(l, r, l.get_allocator());
+    }
+
+    //! Allocates result at once
+    [[nodiscard]] friend constexpr basic_string
+    operator+(string_view l, basic_string const& r)
+    {
+        return concat(l, r, r.get_allocator());
+    }
+
+    //! Allocates result at once
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string const& l, basic_string const& r)
+    {
+        return concat(l, r, l.get_allocator());
+    }
+
+    //! Reuses buffer of `l`
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string&& l, string_view r)
     {
-        return l.append(r);
+        return std::move(l.append(r));
+    }
+
+    //! Reuses buffer of `r`
+    [[nodiscard]] friend constexpr basic_string
+    operator+(string_view l, basic_string&& r)
+    {
+        return std::move(r.insert(r.cbegin(), l));
+    }
+
+    //! Reuses buffer of `l`
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string&& l, basic_string const& r)
+    {
+        return std::move(l.append(r));
+    }
+
+    //! Reuses buffer of `r`
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string const& l, basic_string&& r)
+    {
+        return std::move(r.insert(r.cbegin(), l));
+    }
+
+    //! Reuses buffer of `l` or `r`, preferring one, which doesn't need reallocation
+    [[nodiscard]] friend constexpr basic_string
+    operator+(basic_string&& l, basic_string&& r)
+    {
+        auto const size{ l.size() + r.size() };
+        if (l.capacity() < size && r.capacity() >= size) return std::move(r.insert(r.cbegin(), l));
+
+        return std::move(l.append(r));
     }
 
     constexpr basic_string&
@@ -348,15 +484,27 @@ public:
     }
 
     friend constexpr std::ostream&
-    operator<<(std::ostream& out, basic_string str)
+    operator<<(std::ostream& out, basic_string const& str)
     {
         return out << static_cast<string_view>(str);
     }
 
-    friend constexpr auto
-    operator<=>(basic_string l, basic_string r)
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_string const& l, basic_string const& r) noexcept
     {
-        return static_cast<string_view>(l) <=> static_cast<string_view>(r);
+        return l.buffer.compare(r.buffer);
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_string const& l, string_view const& r) noexcept
+    {
+        return static_cast<string_view>(l) <=> r;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_string const& l, value_type const* r) noexcept
+    {
+        return static_cast<string_view>(l) <=> string_view{ r };
     }
 
     constexpr bool
@@ -379,10 +527,187 @@ public:
     }
 #endif
 
-    constexpr basic_string
-    substr(size_type pos, size_type count)
+    static constexpr size_type npos{ string_view::npos };
+
+    //! Long strings of byte characters are searched by first and last character of `str` 16 or 32 positions at once.
+    //! Complexity: O(`size()` * `str.size()`) in the worst case
+    //! @return index of the first occurrence of `str` starting at or after `pos`, or `npos`
+    [[nodiscard]] constexpr size_type
+    find(string_view str, size_type pos = 0) const noexcept
+    {
+        if constexpr (detail::byte_char<value_type>)
+        {
+            if (!std::is_constant_evaluated() && pos <= size())
+            {
+                auto const found{ detail::search::find(detail::bytes(data()) + pos, size() - pos,
+                                                       detail::bytes(str.data()), str.size()) };
+
+                return found == npos ? npos : pos + found;
+            }
+        }
+
+        return static_cast<string_view>(*this).find(str, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    find(value_type c, size_type pos = 0) const noexcept
+    {
+        return find_of<false, false>(string_view{ &c, 1 }, pos);
+    }
+
+    //! @return index of the last occurrence of `str` starting at or before `pos`, or `npos`
+    [[nodiscard]] constexpr size_type
+    rfind(string_view str, size_type pos = npos) const noexcept
+    {
+        return static_cast<string_view>(*this).rfind(str, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    rfind(value_type c, size_type pos = npos) const noexcept
+    {
+        return find_of<true, false>(string_view{ &c, 1 }, pos);
+    }
+
+    //! Searches of character class are vectorized for byte characters and `set` of up to 16 characters,
+    //! short strings are matched at once, without loop over characters.
+    //! Complexity: O(`size()` * `set.size()`)
+    //! @return index of the first character at or after `pos`, which is in `set`, or `npos`
+    [[nodiscard]] constexpr size_type
+    find_first_of(string_view set, size_type pos = 0) const noexcept
+    {
+        return find_of<false, false>(set, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    find_first_of(value_type c, size_type pos = 0) const noexcept
+    {
+        return find(c, pos);
+    }
+
+    //! @return index of the last character at or before `pos`, which is in `set`, or `npos`
+    [[nodiscard]] constexpr size_type
+    find_last_of(string_view set, size_type pos = npos) const noexcept
+    {
+        return find_of<true, false>(set, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    find_last_of(value_type c, size_type pos = npos) const noexcept
+    {
+        return rfind(c, pos);
+    }
+
+    //! @return index of the first character at or after `pos`, which isn't in `set`, or `npos`
+    [[nodiscard]] constexpr size_type
+    find_first_not_of(string_view set, size_type pos = 0) const noexcept
+    {
+        return find_of<false, true>(set, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    find_first_not_of(value_type c, size_type pos = 0) const noexcept
+    {
+        return find_of<false, true>(string_view{ &c, 1 }, pos);
+    }
+
+    //! @return index of the last character at or before `pos`, which isn't in `set`, or `npos`
+    [[nodiscard]] constexpr size_type
+    find_last_not_of(string_view set, size_type pos = npos) const noexcept
+    {
+        return find_of<true, true>(set, pos);
+    }
+
+    [[nodiscard]] constexpr size_type
+    find_last_not_of(value_type c, size_type pos = npos) const noexcept
+    {
+        return find_of<true, true>(string_view{ &c, 1 }, pos);
+    }
+
+    //! Copies [ `pos`, `pos + min(count, size() - pos)` ), allocator is chosen like by copy constructor
+    //! @throws `std::out_of_range` if `pos > size()`
+    [[nodiscard]] constexpr basic_string
+    substr(size_type pos = 0, size_type count = npos) const&
+    {
+        return concat(view(pos, count), string_view{}, get_allocator());
+    }
+
+    //! Same as `substr() const&`, but characters are moved to the beginning of the same buffer
+    //! instead of allocation of new one (unless heap buffer is shared)
+    //! @throws `std::out_of_range` if `pos > size()`
+    [[nodiscard]] constexpr basic_string
+    substr(size_type pos = 0, size_type count = npos) &&
+    {
+        auto const sub{ view(pos, count) };
+        remove_suffix(size() - pos - sub.size());
+        remove_prefix(pos);
+
+        return std::move(*this);
+    }
+
+    //! Like `substr`, but doesn't copy characters.
+    //! Result is invalidated by modification of `*this` (like `data()`)
+    //! @throws `std::out_of_range` if `pos > size()`
+    [[nodiscard]] constexpr string_view
+    view(size_type pos = 0, size_type count = npos) const
+    {
+        return static_cast<string_view>(*this).substr(pos, count);
+    }
+
+    //! Erases first `count` characters in place, remaining ones are moved
+    //! @pre `count <= size()`
+    constexpr basic_string&
+    remove_prefix(size_type count) noexcept(!Ownership::shared)
+    {
+        assert(count <= size());
+
+        replace(0, count, string_view{});
+
+        return *this;
+    }
+
+    //! Erases last `count` characters in place. Complexity: O(1) unless heap buffer is shared
+    //! @pre `count <= size()`
+    constexpr basic_string&
+    remove_suffix(size_type count) noexcept(!Ownership::shared)
     {
-        return basic_string{ static_cast<string_view>(*this).substr(pos, count) };
+        assert(count <= size());
+
+        replace(size() - count, count, string_view{});
+
+        return *this;
+    }
+
+    //! Erases leading and trailing characters from `set` (ASCII whitespace by default) in place
+    constexpr basic_string&
+    trim(string_view set = detail::ascii::whitespace<Char>()) noexcept(!Ownership::shared)
+    {
+        auto const last{ find_last_not_of(set) };
+        if (last == npos) return remove_suffix(size());
+
+        remove_suffix(size() - last - 1);
+
+        return remove_prefix(find_first_not_of(set));
+    }
+
+    //! Converts ASCII letters to lower case in place, other characters are kept,
+    //! so result doesn't depend on locale (unlike `std::tolower`).
+    //! Long strings of bytes are converted by SIMD, short ones - by words.
+    //! Copies shared heap buffer, see `shared_ownership`
+    constexpr basic_string&
+    to_lower() noexcept(!Ownership::shared)
+    {
+        buffer.template convert_case<false>();
+
+        return *this;
+    }
+
+    //! Converts ASCII letters to upper case in place, see `to_lower()`
+    constexpr basic_string&
+    to_upper() noexcept(!Ownership::shared)
+    {
+        buffer.template convert_case<true>();
+
+        return *this;
     }
 
     constexpr void
@@ -391,10 +716,193 @@ public:
         buffer.resize(size, filler);
     }
 
+    //! Writes characters without filling them first, e.g. by `snprintf`, `read` or decoder.
+    //! `op(data, count)` gets [ `data`, `data + count` ), where first `min(size(), count)` characters
+    //! are the current ones and the rest are uninitialized, and returns new `size()`.
+    //! Works in short mode too, then no allocation takes place.
+    //! @pre `op` returns value in [ 0, `count` ] and doesn't throw
+    //! @throws `std::length_error` if `count > max_size()`
+    template <typename Operation>
+        requires std::is_invocable_v<Operation, value_type*, size_type>
+    constexpr void
+    resize_and_overwrite(size_type count, Operation op)
+    {
+        buffer.resize_and_overwrite(count, std::move(op));
+    }
+
+    //! Extension: `resize` without initialization of new characters, which should be overwritten
+    //! through `data()`. Complexity: O(1) unless reallocation takes place
+    //! @throws `std::length_error` if `size > max_size()`
+    constexpr void
+    resize_uninitialized(size_type size)
+    {
+        buffer.resize_uninitialized(size);
+    }
+
 private:
-    detail::basic_string_buffer<value_type, allocator_type> buffer;
+    friend struct basic_fast_hash<Char>;
+    friend struct basic_case_insensitive_hash<Char>;
+    friend struct basic_case_insensitive_equal<Char>;
+    friend struct basic_case_insensitive_compare<Char>;
+
+    [[nodiscard]] static constexpr basic_string
+    concat(string_view l, string_view r, allocator_type const& allocator)
+    {
+        basic_string result{ allocator_traits::select_on_container_copy_construction(allocator) };
+        result.reserve(l.size() + r.size());
+        result.append(l);
+        result.append(r);
+
+        return result;
+    }
+
+    //! Common implementation of `find_*_of`/`find_*_not_of`
+    //! @return index of the first (last if `Reverse`) character in range given by `pos`,
+    //!         which is in `set` (isn't if `Negate`), or `npos`
+    template <bool Reverse, bool Negate>
+    [[nodiscard]] constexpr size_type
+    find_of(string_view set, size_type pos) const noexcept
+    {
+        auto const first{ Reverse ? 0 : pos };
+        auto const last{ Reverse ? std::min(pos, size() - 1) + 1 : size() };
+        if (first >= last || empty()) return npos;
+
+        if constexpr (detail::byte_char<value_type>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                auto const* const chars{ detail::bytes(set.data()) };
+                if constexpr (detail::search::inline_search<sizeof(buffer.representation())>)
+                {
+                    // short mode: bytes after the string are masked out, so there is no loop over characters
+                    if (buffer.is_inline() && !set.empty() && set.size() <= detail::search::max_vector_set)
+                    {
+                        return detail::search::find_of_inline<Reverse, Negate>(buffer.representation(), first,
+                                                                               last, chars, set.size());
+                    }
+                }
+
+                auto const found{ detail::search::find_of<Reverse, Negate>(
+                    detail::bytes(data()) + first, last - first, chars, set.size()) };
+
+                return found == npos ? npos : first + found;
+            }
+        }
+
+        string_view const range{ data() + first, last - first };
+        auto const found{ Reverse ? (Negate ? range.find_last_not_of(set) : range.find_last_of(set))
+                                  : (Negate ? range.find_first_not_of(set) : range.find_first_of(set)) };
+
+        return found == npos ? npos : first + found;
+    }
+
+    basic_string_buffer buffer;
 };
 
 using string = basic_string<char>;
 
+//! Neither representation points into the string itself: inline characters are addressed from `this`
+//! on each access, heap buffer and its reference counter don't depend on address of the string
+template <typename Char, typename Allocator, growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          ownership_policy Ownership>
+struct is_trivially_relocatable<basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>>
+    : is_trivially_relocatable<Allocator>
+{
+};
+
+//! String, which stores at least `InlineCapacity` chars without allocation
+template <std::size_t InlineCapacity>
+using small_string = basic_string<char, std::allocator<char>, geometric_growth, InlineCapacity>;
+
+//! String, which shares heap buffer between copies (copy-on-write)
+using shared_string = basic_string<char, std::allocator<char>, geometric_growth, 0, shared_ownership>;
+
+namespace pmr
+{
+
+template <typename Char>
+using basic_string = sso::basic_string<Char, std::pmr::polymorphic_allocator<Char>>;
+
+using string = basic_string<char>;
+
+} // namespace pmr
+
+//! Transparent hasher, allows heterogeneous lookup by `string_view`/`Char const*` in unordered containers.
+//! Result is the same as of `std::hash<basic_string>` and `std::hash<std::basic_string_view>`.
+template <typename Char>
+struct basic_string_hash
+{
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t
+    operator()(std::basic_string_view<Char> str) const noexcept
+    {
+        return std::hash<std::basic_string_view<Char>>{}(str);
+    }
+};
+
+//! Transparent equality, see `basic_string_hash`
+template <typename Char>
+struct basic_string_equal
+{
+    using is_transparent = void;
+
+    [[nodiscard]] constexpr bool
+    operator()(std::basic_string_view<Char> l, std::basic_string_view<Char> r) const noexcept
+    {
+        return l == r;
+    }
+};
+
+using string_hash = basic_string_hash<char>;
+using string_equal = basic_string_equal<char>;
+
+inline namespace literals
+{
+
+//! `"text"_ss` is `sso::string` made at compile time: inline buffer is a ready constant, so nothing
+//! is constructed at runtime, and `constexpr` tables of such strings are placed in read-only data.
+//! Literal must fit `string::inline_capacity()`, otherwise it doesn't compile
+[[nodiscard]] consteval string
+operator""_ss(char const* str, std::size_t size)
+{
+    return string{ std::string_view{ str, size } };
+}
+
+[[nodiscard]] consteval basic_string<wchar_t>
+operator""_ss(wchar_t const* str, std::size_t size)
+{
+    return basic_string<wchar_t>{ std::wstring_view{ str, size } };
+}
+
+} // namespace literals
+
 } // namespace sso
+
+template <typename Char, typename Allocator, sso::growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          sso::ownership_policy Ownership>
+struct std::hash<sso::basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>>
+{
+    [[nodiscard]] std::size_t
+    operator()(sso::basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& str) const noexcept
+    {
+        return std::hash<std::basic_string_view<Char>>{}(str);
+    }
+};
+
+//! Formats as `std::basic_string_view`, so the same format specification (fill, width, precision) is accepted,
+//! without copying characters like `operator<<`
+template <typename Char, typename Allocator, sso::growth_policy GrowthPolicy, std::size_t InlineCapacity,
+          sso::ownership_policy Ownership>
+struct std::formatter<sso::basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership>, Char>
+    : std::formatter<std::basic_string_view<Char>, Char>
+{
+    template <typename FormatContext>
+    auto
+    format(sso::basic_string<Char, Allocator, GrowthPolicy, InlineCapacity, Ownership> const& str,
+           FormatContext& context) const
+    {
+        return std::formatter<std::basic_string_view<Char>, Char>::format(static_cast<std::basic_string_view<Char>>(str),
+                                                                           context);
+    }
+};
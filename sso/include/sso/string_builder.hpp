@@ -0,0 +1,293 @@
+#pragma once
+
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#endif
+
+namespace sso
+{
+
+//! Accumulates large text as sequence of chunks instead of single growing buffer.
+//! Copied text is placed into blocks of fixed size, moved `String`s become chunks of their own,
+//! so nothing is reallocated or copied twice. Result is produced by `str()` with single allocation
+//! of exact size, or written chunk by chunk (see `chunks()` and `to_iovec()`).
+//! @tparam String specialization of `sso::basic_string`, which chunks and result are made of
+template <typename String>
+struct basic_string_builder
+{
+private:
+    using allocator_traits = std::allocator_traits<typename String::allocator_type>;
+    struct chunk;
+    using chunk_allocator = allocator_traits::template rebind_alloc<chunk>;
+
+public:
+    using string_type = String;
+    using value_type = String::value_type;
+    using size_type = String::size_type;
+    using allocator_type = String::allocator_type;
+    using string_view = String::string_view;
+
+    //! Capacity of blocks for copied text, in characters
+    static constexpr size_type default_block_size{ 4096 };
+
+    explicit basic_string_builder(size_type block_size = default_block_size,
+                                  allocator_type const& allocator = allocator_type())
+        : chunks_(chunk_allocator{ allocator })
+        , block_size_{ block_size }
+    {
+    }
+
+    explicit basic_string_builder(allocator_type const& allocator)
+        : basic_string_builder{ default_block_size, allocator }
+    {
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] allocator_type
+    get_allocator() const
+    {
+        return chunks_.get_allocator();
+    }
+
+    //! @return number of elements of `chunks()`
+    [[nodiscard]] size_type
+    chunk_count() const noexcept
+    {
+        return chunks_.size();
+    }
+
+    //! Copies `str` into spare capacity of the last block, the rest goes to new block
+    //! of `max(block_size, rest)` characters.
+    //! Complexity: O(`str.size()`)
+    basic_string_builder&
+    append(string_view str)
+    {
+        if (str.empty()) return *this;
+
+        if (str.size() <= tail_capacity_ - tail_size_) [[likely]]
+        {
+            copy_to_tail(str);
+            return *this;
+        }
+
+        if (tail_capacity_ != 0)
+        {
+            auto const count{ tail_capacity_ - tail_size_ };
+            copy_to_tail(str.substr(0, count));
+            str.remove_prefix(count);
+        }
+        start_block(std::max(block_size_, str.size()));
+        copy_to_tail(str);
+
+        return *this;
+    }
+
+    //! Takes `str` as chunk without copying its characters,
+    //! unless it fits into spare capacity of the last block.
+    //! Complexity: O(1)
+    basic_string_builder&
+    append(String&& str)
+    {
+        if (str.size() <= tail_capacity_ - tail_size_) return append(string_view(str));
+
+        finish_tail();
+        size_ += str.size();
+        chunks_.push_back({ std::move(str) });
+
+        return *this;
+    }
+
+    basic_string_builder&
+    push_back(value_type value)
+    {
+        return append(string_view(&value, 1));
+    }
+
+    basic_string_builder&
+    operator+=(string_view str)
+    {
+        return append(str);
+    }
+
+    basic_string_builder&
+    operator+=(String&& str)
+    {
+        return append(std::move(str));
+    }
+
+    basic_string_builder&
+    operator+=(value_type value)
+    {
+        return push_back(value);
+    }
+
+    //! Concatenates chunks into string, which allocates exactly `size() + 1` characters (unless it is short)
+    [[nodiscard]] String
+    str() const&
+    {
+        String result(get_allocator());
+        result.reserve(size_);
+        for (auto const chunk : chunks()) result.append(chunk);
+
+        return result;
+    }
+
+    //! Same as `str() const&`, but single moved chunk is returned as is
+    //! @post `empty()`
+    [[nodiscard]] String
+    str() &&
+    {
+        finish_tail();
+        String result{ chunks_.size() == 1 && offset_ == 0 ? std::move(chunks_.front().str) : std::as_const(*this).str() };
+        clear();
+
+        return result;
+    }
+
+    //! @return `string_view`s of chunks in order, they are invalidated by `consume()` and `clear()`
+    [[nodiscard]] auto
+    chunks() const noexcept
+    {
+        return std::views::iota(size_type{ 0 }, chunks_.size())
+             | std::views::transform([this](size_type index) { return view(index); });
+    }
+
+    //! Drops first `count` characters, e.g. after partial write.
+    //! Complexity: O(number of dropped chunks)
+    //! @pre `count <= size()`
+    void
+    consume(size_type count) noexcept
+    {
+        size_ -= count;
+        while (count != 0 && count >= view(0).size())
+        {
+            count -= view(0).size();
+            chunks_.pop_front();
+            offset_ = 0;
+        }
+        offset_ += count;
+        if (chunks_.empty()) tail_capacity_ = tail_size_ = 0;
+    }
+
+    //! Frees all chunks
+    //! @post `empty()`
+    void
+    clear() noexcept
+    {
+        chunks_.clear();
+        size_ = 0;
+        offset_ = 0;
+        tail_capacity_ = tail_size_ = 0;
+    }
+
+#if __has_include(<sys/uio.h>)
+    //! Describes first chunks for scatter/gather output (`writev`, `sendmsg`), written characters
+    //! should then be dropped by `consume()`.
+    //! @return number of filled elements of `out`, at most `chunk_count()`
+    std::size_t
+    to_iovec(std::span<iovec> out) const noexcept
+    {
+        auto const count{ std::min(out.size(), chunks_.size()) };
+        for (std::size_t i{ 0 }; i != count; ++i)
+        {
+            auto const str{ view(i) };
+            out[i].iov_base = const_cast<value_type*>(str.data());
+            out[i].iov_len = str.size() * sizeof(value_type);
+        }
+
+        return count;
+    }
+#endif
+
+private:
+    //! Isn't constructed with allocator of container (unlike `String` in `std::pmr` containers),
+    //! so moved strings keep their own allocator
+    struct chunk
+    {
+        String str;
+    };
+
+    [[nodiscard]] string_view
+    view(size_type index) const noexcept
+    {
+        string_view result{ chunks_[index].str };
+        if (tail_capacity_ != 0 && index + 1 == chunks_.size()) result = result.substr(0, tail_size_);
+        if (index == 0) result.remove_prefix(offset_);
+
+        return result;
+    }
+
+    //! Block is filled to its capacity, so characters are appended without bookkeeping of `String`
+    void
+    start_block(size_type capacity)
+    {
+        finish_tail();
+        auto& block{ chunks_.emplace_back(String(get_allocator())).str };
+        block.reserve(capacity);
+        block.resize_uninitialized(block.capacity());
+        tail_capacity_ = block.size();
+    }
+
+    //! Trims the last block to its used characters, it isn't appended to anymore
+    void
+    finish_tail()
+    {
+        if (tail_capacity_ == 0) return;
+
+        chunks_.back().str.resize(tail_size_);
+        tail_capacity_ = tail_size_ = 0;
+    }
+
+    //! @pre `str.size() <= tail_capacity_ - tail_size_`
+    void
+    copy_to_tail(string_view str)
+    {
+        std::ranges::copy(str, chunks_.back().str.data() + tail_size_);
+        tail_size_ += str.size();
+        size_ += str.size();
+    }
+
+    std::deque<chunk, chunk_allocator> chunks_;
+    size_type size_{ 0 };
+    //! Number of consumed characters of the first chunk
+    size_type offset_{ 0 };
+    size_type block_size_;
+    //! Size and used characters of the last chunk, if it is block allocated by `append(string_view)`,
+    //! otherwise zeros
+    size_type tail_capacity_{ 0 };
+    size_type tail_size_{ 0 };
+};
+
+using string_builder = basic_string_builder<string>;
+
+namespace pmr
+{
+
+using string_builder = basic_string_builder<string>;
+
+} // namespace pmr
+
+} // namespace sso
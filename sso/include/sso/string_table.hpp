@@ -0,0 +1,368 @@
+#pragma once
+
+#include <sso/hash.hpp>
+#include <sso/string.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sso
+{
+
+//! Sequence of immutable strings, characters of which are packed one after another into single buffer.
+//! Unlike `std::vector<basic_string>` it takes only an offset per string besides characters
+//! and doesn't allocate per long string, e.g. for string columns of millions of rows.
+//! Adding strings invalidates `string_view`s and `c_str()` pointers (like `std::vector`), but not handles.
+template <typename Char, typename Allocator = std::allocator<Char>>
+struct basic_string_table
+{
+private:
+    using allocator_traits = std::allocator_traits<Allocator>;
+    using offset_allocator = allocator_traits::template rebind_alloc<typename allocator_traits::size_type>;
+
+public:
+    using size_type = allocator_traits::size_type;
+    using difference_type = allocator_traits::difference_type;
+    using allocator_type = Allocator;
+    using string_view = std::basic_string_view<Char>;
+    using value_type = string_view;
+
+    //! Identifies string in the table, stays valid until the table is reordered (`sort`, `deduplicate`)
+    struct handle
+    {
+        size_type index;
+
+        [[nodiscard]] friend constexpr auto
+        operator<=>(handle, handle) noexcept = default;
+    };
+
+    struct const_iterator;
+    using iterator = const_iterator;
+
+    basic_string_table()
+        : basic_string_table{ allocator_type() }
+    {
+    }
+
+    explicit basic_string_table(allocator_type const& allocator)
+        : chars_(allocator)
+        , offsets_(1, 0, offset_allocator{ allocator })
+    {
+    }
+
+    //! Copies strings, e.g. `basic_string`s, `std::basic_string`s or `string_view`s
+    template <std::ranges::input_range Range>
+        requires std::convertible_to<std::ranges::range_reference_t<Range>, string_view>
+    explicit basic_string_table(Range&& strings, allocator_type const& allocator = allocator_type())
+        : basic_string_table{ allocator }
+    {
+        if constexpr (std::ranges::sized_range<Range>) offsets_.reserve(std::ranges::size(strings) + 1);
+        for (string_view str : strings) push_back(str);
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    {
+        return offsets_.size() - 1;
+    }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    //! @return number of stored characters, including null-terminator of each string
+    [[nodiscard]] size_type
+    chars_size() const noexcept
+    {
+        return chars_.size();
+    }
+
+    [[nodiscard]] allocator_type
+    get_allocator() const
+    {
+        return chars_.get_allocator();
+    }
+
+    //! Preallocates memory for `count` strings of `chars` characters in total (excluding null-terminators)
+    void
+    reserve(size_type count, size_type chars)
+    {
+        offsets_.reserve(count + 1);
+        chars_.reserve(chars + count);
+    }
+
+    //! Appends copy of `str`, followed by null-terminator. `str` may refer to string of `*this`.
+    //! Complexity: amortized O(`str.size()`)
+    //! @return handle of the copy
+    handle
+    push_back(string_view str)
+    {
+        // growth frees old characters, so `str` is found again by its offset
+        auto const old_size{ chars_.size() };
+        auto const inside{ !chars_.empty() && !std::less<>{}(str.data(), chars_.data())
+                           && std::less<>{}(str.data(), chars_.data() + old_size) };
+        auto const offset{ inside ? static_cast<size_type>(str.data() - chars_.data()) : 0 };
+
+        chars_.resize(old_size + str.size() + 1);
+        auto const* const src{ inside ? chars_.data() + offset : str.data() };
+        std::copy_n(src, str.size(), chars_.data() + old_size);
+        chars_.back() = Char{};
+        offsets_.push_back(chars_.size());
+
+        return { size() - 1 };
+    }
+
+    //! @pre `index < size()`
+    [[nodiscard]] string_view
+    operator[](size_type index) const noexcept
+    {
+        return { chars_.data() + offsets_[index], offsets_[index + 1] - offsets_[index] - 1 };
+    }
+
+    [[nodiscard]] string_view
+    operator[](handle handle) const noexcept
+    {
+        return (*this)[handle.index];
+    }
+
+    //! @return null-terminated string
+    [[nodiscard]] Char const*
+    c_str(handle handle) const noexcept
+    {
+        return chars_.data() + offsets_[handle.index];
+    }
+
+    [[nodiscard]] const_iterator
+    begin() const noexcept
+    {
+        return { this, 0 };
+    }
+
+    [[nodiscard]] const_iterator
+    end() const noexcept
+    {
+        return { this, size() };
+    }
+
+    //! Keeps capacity
+    //! @post `empty()`
+    void
+    clear() noexcept
+    {
+        chars_.clear();
+        offsets_.resize(1);
+    }
+
+    //! Reorders strings by `compare`, storage is rebuilt in the new order,
+    //! so sequential access stays sequential in memory
+    //! Complexity: O(N log N) comparisons and O(`chars_size()`) copying
+    template <typename Compare = std::ranges::less>
+    void
+    sort(Compare compare = {})
+    {
+        std::vector<size_type> order(size());
+        std::iota(order.begin(), order.end(), size_type{ 0 });
+        std::ranges::stable_sort(order, compare, [this](size_type index) { return (*this)[index]; });
+
+        basic_string_table sorted{ get_allocator() };
+        sorted.reserve(size(), chars_size() - size());
+        for (auto const index : order) sorted.push_back((*this)[index]);
+
+        swap(*this, sorted);
+    }
+
+    //! Removes repeated strings, keeping the first occurrence of each in the same order
+    //! (dictionary encoding of a column).
+    //! Complexity: O(`chars_size()`) on average
+    //! @return new handles of removed and kept strings: `result[i]` refers to string, which was `i`-th
+    std::vector<handle>
+    deduplicate()
+    {
+        std::unordered_map<string_view, handle, basic_fast_hash<Char>> unique;
+        unique.reserve(size());
+
+        basic_string_table result{ get_allocator() };
+        std::vector<handle> handles;
+        handles.reserve(size());
+        for (auto const str : *this)
+        {
+            auto const [it, inserted]{ unique.try_emplace(str, handle{ result.size() }) };
+            if (inserted) result.push_back(str);
+            handles.push_back(it->second);
+        }
+
+        swap(*this, result);
+
+        return handles;
+    }
+
+    [[nodiscard]] friend bool
+    operator==(basic_string_table const& l, basic_string_table const& r) noexcept
+    {
+        return l.offsets_ == r.offsets_ && l.chars_ == r.chars_;
+    }
+
+    friend void
+    swap(basic_string_table& l, basic_string_table& r) noexcept
+    {
+        using std::swap;
+
+        swap(l.chars_, r.chars_);
+        swap(l.offsets_, r.offsets_);
+    }
+
+private:
+    std::vector<Char, Allocator> chars_;
+    //! `offsets_[i]` is the first character of `i`-th string, the last element is `chars_.size()`
+    std::vector<size_type, offset_allocator> offsets_;
+};
+
+//! Yields `string_view`s by value, so it is `std::random_access_iterator`, but only input iterator
+//! for algorithms, which require references
+template <typename Char, typename Allocator>
+struct basic_string_table<Char, Allocator>::const_iterator
+{
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = string_view;
+    using difference_type = basic_string_table::difference_type;
+    using reference = string_view;
+
+    const_iterator() = default;
+
+    const_iterator(basic_string_table const* table, size_type index) noexcept
+        : table_{ table }
+        , index_{ index }
+    {
+    }
+
+    [[nodiscard]] string_view
+    operator*() const noexcept
+    {
+        return (*table_)[index_];
+    }
+
+    [[nodiscard]] string_view
+    operator[](difference_type offset) const noexcept
+    {
+        return *(*this + offset);
+    }
+
+    //! @return handle of current string
+    [[nodiscard]] handle
+    get_handle() const noexcept
+    {
+        return { index_ };
+    }
+
+    const_iterator&
+    operator++() noexcept
+    {
+        ++index_;
+        return *this;
+    }
+
+    const_iterator
+    operator++(int) noexcept
+    {
+        auto const result{ *this };
+        ++index_;
+        return result;
+    }
+
+    const_iterator&
+    operator--() noexcept
+    {
+        --index_;
+        return *this;
+    }
+
+    const_iterator
+    operator--(int) noexcept
+    {
+        auto const result{ *this };
+        --index_;
+        return result;
+    }
+
+    const_iterator&
+    operator+=(difference_type offset) noexcept
+    {
+        index_ = static_cast<size_type>(static_cast<difference_type>(index_) + offset);
+        return *this;
+    }
+
+    const_iterator&
+    operator-=(difference_type offset) noexcept
+    {
+        return *this += -offset;
+    }
+
+    [[nodiscard]] friend const_iterator
+    operator+(const_iterator it, difference_type offset) noexcept
+    {
+        return it += offset;
+    }
+
+    [[nodiscard]] friend const_iterator
+    operator+(difference_type offset, const_iterator it) noexcept
+    {
+        return it += offset;
+    }
+
+    [[nodiscard]] friend const_iterator
+    operator-(const_iterator it, difference_type offset) noexcept
+    {
+        return it -= offset;
+    }
+
+    [[nodiscard]] friend difference_type
+    operator-(const_iterator const& l, const_iterator const& r) noexcept
+    {
+        return static_cast<difference_type>(l.index_) - static_cast<difference_type>(r.index_);
+    }
+
+    [[nodiscard]] friend bool
+    operator==(const_iterator const& l, const_iterator const& r) noexcept
+    {
+        return l.index_ == r.index_;
+    }
+
+    [[nodiscard]] friend std::strong_ordering
+    operator<=>(const_iterator const& l, const_iterator const& r) noexcept
+    {
+        return l.index_ <=> r.index_;
+    }
+
+private:
+    basic_string_table const* table_{ nullptr };
+    size_type index_{ 0 };
+};
+
+using string_table = basic_string_table<char>;
+
+namespace pmr
+{
+
+template <typename Char>
+using basic_string_table = sso::basic_string_table<Char, std::pmr::polymorphic_allocator<Char>>;
+
+using string_table = basic_string_table<char>;
+
+} // namespace pmr
+
+} // namespace sso
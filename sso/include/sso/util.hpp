@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
 #include <format>
 #include <iostream>
@@ -31,4 +32,47 @@ unreachable()
 #endif
 }
 
+//! `std::byteswap` of C++23, compilers recognize it as single instruction
+[[nodiscard]] constexpr std::uint64_t
+byteswap(std::uint64_t value) noexcept
+{
+    value = ((value & 0x00ff00ff00ff00ffull) << 8) | ((value >> 8) & 0x00ff00ff00ff00ffull);
+    value = ((value & 0x0000ffff0000ffffull) << 16) | ((value >> 16) & 0x0000ffff0000ffffull);
+
+    return (value << 32) | (value >> 32);
+}
+
+//! Branchless `condition ? l : r`.
+//! Compilers tend to turn ternary over cheap values into jump,
+//! which is mispredicted when `condition` is random (e.g. short and long strings are mixed).
+template <typename T>
+[[nodiscard]] constexpr T
+select(bool condition, T l, T r) noexcept
+{
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+    {
+        using unsigned_type = std::make_unsigned_t<T>;
+        auto const mask{ static_cast<unsigned_type>(unsigned_type{} - condition) };
+
+        return static_cast<T>((static_cast<unsigned_type>(l) & mask)
+                              | (static_cast<unsigned_type>(r) & ~mask));
+    } else if constexpr (std::is_pointer_v<T>)
+    {
+        if (std::is_constant_evaluated()) return condition ? l : r;
+
+        auto const mask{ static_cast<std::uintptr_t>(std::uintptr_t{} - condition) };
+
+        return reinterpret_cast<T>((reinterpret_cast<std::uintptr_t>(l) & mask)
+                                   | (reinterpret_cast<std::uintptr_t>(r) & ~mask));
+    } else
+    {
+        return condition ? l : r;
+    }
+}
+
+//! Allocator, which declares `using is_monotonic = std::true_type`, doesn't free memory in `deallocate`,
+//! it is released all at once by its resource (see `sso::arena_allocator`)
+template <typename Allocator>
+concept monotonic_allocator = requires { typename Allocator::is_monotonic; } && Allocator::is_monotonic::value;
+
 } // namespace sso::detail
@@ -0,0 +1,16 @@
+// Compiled with optimizations and disassembled by `check_branchless.cmake`:
+// functions with `sso_codegen_` prefix must not contain conditional jumps.
+
+#include <sso/string.hpp>
+
+extern "C" sso::string::const_pointer
+sso_codegen_data(sso::string const& s)
+{
+    return s.data();
+}
+
+extern "C" sso::string::size_type
+sso_codegen_size(sso::string const& s)
+{
+    return s.size();
+}
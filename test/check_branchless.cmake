@@ -0,0 +1,31 @@
+# usage: cmake -DOBJDUMP=<objdump> -DOBJECT=<object file> -P check_branchless.cmake
+#
+# Fails if any function with `sso_codegen_` prefix contains conditional jump.
+
+execute_process(
+  COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OBJECT}"
+  OUTPUT_VARIABLE disassembly
+  RESULT_VARIABLE result)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "`${OBJDUMP}` failed on `${OBJECT}`")
+endif()
+
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(function "")
+set(checked 0)
+foreach(line IN LISTS lines)
+  if(line MATCHES "^[0-9a-f]+ <([^>]+)>:$")
+    set(function "${CMAKE_MATCH_1}")
+    if(function MATCHES "^sso_codegen_")
+      math(EXPR checked "${checked} + 1")
+    endif()
+  elseif(function MATCHES "^sso_codegen_" AND line MATCHES "\tj[^m][a-z]*[ \t]")
+    message(SEND_ERROR "conditional jump in `${function}`:\n${line}")
+  endif()
+endforeach()
+
+if(checked EQUAL 0)
+  message(FATAL_ERROR "no `sso_codegen_*` functions found in `${OBJECT}`")
+endif()
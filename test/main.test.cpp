@@ -2,13 +2,129 @@
 #define DOCTEST_CONFIG_VOID_CAST_EXPRESSIONS
 #include <doctest/doctest.h>
 
+#include <sso/algorithm.hpp>
+#include <sso/arena.hpp>
+#include <sso/case_insensitive.hpp>
+#include <sso/format.hpp>
+#include <sso/hash.hpp>
+#include <sso/interned_string.hpp>
+#include <sso/relocate.hpp>
 #include <sso/string.hpp>
-
+#include <sso/string_builder.hpp>
+#include <sso/string_table.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <format>
+#include <map>
 #include <memory_resource>
 #include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <version>
 
+namespace
+{
+
+//! Counts bytes, which are allocated but not deallocated yet
+struct tracking_resource : std::pmr::memory_resource
+{
+    std::ptrdiff_t outstanding{ 0 };
+
+    void*
+    do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding += static_cast<std::ptrdiff_t>(bytes);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void
+    do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding -= static_cast<std::ptrdiff_t>(bytes);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool
+    do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+//! Stateful allocator, which is propagated on copy/move assignment and swap
+template <typename T>
+struct propagating_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    propagating_allocator(std::pmr::memory_resource* resource) noexcept
+        : resource{ resource }
+    {
+    }
+
+    template <typename U>
+    propagating_allocator(propagating_allocator<U> const& other) noexcept
+        : resource{ other.resource }
+    {
+    }
+
+    T*
+    allocate(std::size_t count)
+    {
+        return static_cast<T*>(resource->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T* p, std::size_t count)
+    {
+        resource->deallocate(p, count * sizeof(T), alignof(T));
+    }
+
+    bool
+    operator==(propagating_allocator const&) const = default;
+
+    std::pmr::memory_resource* resource;
+};
+
+//! Formatted as `length` characters 'x', formatter throws after writing them on `throw_at`-th call
+struct throwing_argument
+{
+    std::size_t length;
+    int throw_at;
+    int* calls;
+};
+
+} // namespace
+
+template <>
+struct std::formatter<throwing_argument>
+{
+    constexpr auto
+    parse(std::format_parse_context& context)
+    {
+        return context.begin();
+    }
+
+    auto
+    format(throwing_argument const& argument, std::format_context& context) const
+    {
+        auto out{ std::fill_n(context.out(), argument.length, 'x') };
+        if (++*argument.calls == argument.throw_at) throw std::runtime_error{ "formatter failed" };
+
+        return out;
+    }
+};
+
 TEST_SUITE("sso")
 {
     TEST_CASE("empty string")
@@ -70,6 +186,178 @@ TEST_SUITE("sso")
         REQUIRE_EQ(s1.get_allocator(), allocator);
     }
 
+    TEST_CASE("pmr alias")
+    {
+        static_assert(std::is_same_v<sso::pmr::string::allocator_type, std::pmr::polymorphic_allocator<char>>);
+
+        tracking_resource resource;
+        {
+            sso::pmr::string s{ &resource };
+            s.append("this string is too long for small buffer");
+            REQUIRE_GT(resource.outstanding, 0);
+            REQUIRE_EQ(s.get_allocator().resource(), &resource);
+        }
+        REQUIRE_EQ(resource.outstanding, 0);
+
+        {
+            std::string_view const long_str{ "this string is too long for small buffer" };
+            sso::pmr::string const from_view{ long_str, &resource };
+            REQUIRE_EQ(from_view, long_str);
+            REQUIRE_EQ(from_view.get_allocator().resource(), &resource);
+            auto const outstanding{ resource.outstanding };
+            REQUIRE_GT(outstanding, 0);
+
+            sso::pmr::string const from_c_str{ long_str.data(), &resource };
+            REQUIRE_EQ(from_c_str, long_str);
+            REQUIRE_GT(resource.outstanding, outstanding);
+
+            sso::pmr::string const filled{ 100, 'x', &resource };
+            REQUIRE_EQ(filled, std::string(100, 'x'));
+            REQUIRE_EQ(filled.get_allocator().resource(), &resource);
+
+            sso::pmr::string const short_str{ std::string_view{ "short" }, &resource };
+            REQUIRE_EQ(short_str.get_allocator().resource(), &resource);
+        }
+        REQUIRE_EQ(resource.outstanding, 0);
+    }
+
+    TEST_CASE("propagate allocator")
+    {
+        using string = sso::basic_string<char, propagating_allocator<char>>;
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        tracking_resource first;
+        tracking_resource second;
+        {
+            string l{ &first };
+            l.append(long_str);
+            string r{ &second };
+            r.append(long_str.substr(1));
+
+            SUBCASE("copy assignment")
+            {
+                l = r;
+                REQUIRE_EQ(l, r);
+                REQUIRE_EQ(l.get_allocator().resource, &second);
+                REQUIRE_EQ(first.outstanding, 0);
+            }
+            SUBCASE("move assignment")
+            {
+                l = std::move(r);
+                REQUIRE_EQ(l, long_str.substr(1));
+                REQUIRE_EQ(l.get_allocator().resource, &second);
+                REQUIRE_EQ(first.outstanding, 0);
+            }
+            SUBCASE("swap")
+            {
+                swap(l, r);
+                REQUIRE_EQ(l, long_str.substr(1));
+                REQUIRE_EQ(r, long_str);
+                REQUIRE_EQ(l.get_allocator().resource, &second);
+                REQUIRE_EQ(r.get_allocator().resource, &first);
+            }
+        }
+        REQUIRE_EQ(first.outstanding, 0);
+        REQUIRE_EQ(second.outstanding, 0);
+    }
+
+    TEST_CASE("unequal allocators")
+    {
+        using string = sso::pmr::string;
+        std::string const long_str{ "this string is too long for small buffer" };
+
+        tracking_resource first;
+        tracking_resource second;
+        {
+            string l{ &first };
+            string r{ &second };
+
+            SUBCASE("swap short strings")
+            {
+                l.append("left");
+                r.append("right");
+            }
+            SUBCASE("swap short and long strings")
+            {
+                l.append("left");
+                r.append(long_str);
+            }
+            SUBCASE("swap long strings")
+            {
+                l.append(long_str + "left");
+                r.append(long_str + "right");
+            }
+            std::string const l_value{ l };
+            std::string const r_value{ r };
+
+            swap(l, r);
+            REQUIRE_EQ(l, r_value);
+            REQUIRE_EQ(r, l_value);
+            REQUIRE_EQ(l.get_allocator().resource(), &first);
+            REQUIRE_EQ(r.get_allocator().resource(), &second);
+
+            swap(l, r);
+            REQUIRE_EQ(l, l_value);
+            REQUIRE_EQ(r, r_value);
+
+            // copy and move reuse capacity of the target
+            l.reserve(100);
+            auto const* const data{ std::as_const(l).data() };
+            l = r;
+            REQUIRE_EQ(l, r_value);
+            REQUIRE_EQ(std::as_const(l).data(), data);
+            r.append("!");
+            l = std::move(r);
+            REQUIRE_EQ(l, r_value + "!");
+            REQUIRE_EQ(std::as_const(l).data(), data);
+            REQUIRE(r.empty());
+            REQUIRE_EQ(l.get_allocator().resource(), &first);
+        }
+        REQUIRE_EQ(first.outstanding, 0);
+        REQUIRE_EQ(second.outstanding, 0);
+
+        REQUIRE(std::is_nothrow_swappable_v<sso::string>);
+        REQUIRE_FALSE(std::is_nothrow_swappable_v<sso::pmr::string>);
+    }
+
+    TEST_CASE("arena allocator")
+    {
+        static_assert(std::is_trivially_destructible_v<sso::arena_string>);
+        static_assert(!std::is_trivially_destructible_v<sso::string>);
+        static_assert(!std::is_trivially_destructible_v<sso::basic_string<
+                          char, sso::arena_allocator<char>, sso::geometric_growth, 0, sso::shared_ownership>>);
+
+        std::string const long_str{ "this string is too long for small buffer" };
+
+        sso::arena arena{ 256 };
+        {
+            std::vector<sso::arena_string> strings;
+            for (int i{ 0 }; i < 100; ++i) strings.emplace_back(arena).append(long_str + std::to_string(i));
+            REQUIRE_EQ(strings[42], long_str + "42");
+            REQUIRE_EQ(strings.back().get_allocator().resource(), &arena);
+
+            sso::arena_string large{ arena };
+            large.append(std::string(1000, 'x'));
+            REQUIRE_EQ(large.size(), 1000);
+
+            sso::arena_string const direct{ std::string_view{ long_str }, arena };
+            REQUIRE_EQ(direct, long_str);
+            REQUIRE_EQ(direct.get_allocator().resource(), &arena);
+
+            auto copy{ strings.front() };
+            copy.append("!");
+            REQUIRE_EQ(copy, long_str + "0!");
+        }
+        REQUIRE_GE(arena.capacity(), 100 * long_str.size());
+
+        arena.release();
+        REQUIRE_EQ(arena.capacity(), 0);
+
+        sso::arena_string s{ arena };
+        s.append(long_str);
+        REQUIRE_EQ(s, long_str);
+    }
+
     TEST_CASE("copy/move ctor/assignment operator")
     {
         {
@@ -183,6 +471,85 @@ TEST_SUITE("sso")
         static_assert(sizeof(sso::string) == 24);
     }
 
+    TEST_CASE("null-terminator inside")
+    {
+        using namespace std::string_view_literals;
+
+        {
+            auto const sv{ "1\0" "23"sv };
+            sso::string s{ sv };
+            REQUIRE_EQ(s.size(), sv.size());
+            REQUIRE_EQ(s, sv);
+        }
+        {
+            sso::string s(3, '\0');
+            REQUIRE_EQ(s.size(), 3);
+            s.push_back('x');
+            REQUIRE_EQ(s.size(), 4);
+            REQUIRE_EQ(s.back(), 'x');
+        }
+    }
+
+    TEST_CASE("full small string")
+    {
+        std::string_view const sv{ "0123456789abcdefghijklm" };
+        REQUIRE_EQ(sv.size(), 23);
+
+        sso::string s{ sv };
+        REQUIRE_EQ(s.size(), sv.size());
+        REQUIRE_EQ(s.capacity(), sv.size());
+        REQUIRE_EQ(std::strcmp(s.c_str(), sv.data()), 0);
+
+        s.pop_back();
+        REQUIRE_EQ(s.size(), sv.size() - 1);
+        REQUIRE_EQ(s, sv.substr(0, sv.size() - 1));
+    }
+
+    TEST_CASE("configurable inline capacity")
+    {
+        static_assert(sizeof(sso::string) == 24);
+        static_assert(sso::string::inline_capacity() == 23);
+        static_assert(sizeof(sso::small_string<10>) == sizeof(sso::string));
+        static_assert(sso::small_string<10>::inline_capacity() == 23);
+        static_assert(sizeof(sso::small_string<63>) == 64);
+        static_assert(sso::small_string<63>::inline_capacity() == 63);
+        static_assert(sso::small_string<60>::inline_capacity() == 63);
+        static_assert(sso::basic_string<char32_t, std::allocator<char32_t>, sso::geometric_growth, 9>::inline_capacity() == 9);
+
+        // any allocation throws
+        std::pmr::monotonic_buffer_resource resource{ std::pmr::null_memory_resource() };
+        using string = sso::basic_string<char, std::pmr::polymorphic_allocator<char>, sso::geometric_growth, 63>;
+
+        std::string_view const sv{ "identifier::which_is::longer_than_23_chars::but_fits_in_63" };
+        string s{ &resource };
+        s.append(sv);
+        REQUIRE_EQ(s, sv);
+        REQUIRE_EQ(std::strlen(s.c_str()), sv.size());
+
+        s.append(std::string(string::inline_capacity() - s.size(), 'x'));
+        REQUIRE_EQ(s.size(), 63);
+        REQUIRE_EQ(s.capacity(), 63);
+        REQUIRE_EQ(s.back(), 'x');
+        REQUIRE_EQ(std::strlen(s.c_str()), 63);
+
+        auto const copy{ s };
+        REQUIRE_EQ(copy, s);
+        REQUIRE(!(copy < s));
+
+        s.pop_back();
+        REQUIRE_LT(s, copy);
+        REQUIRE_THROWS_AS(s.append("yz"), std::bad_alloc);
+
+        sso::small_string<63> heap{ std::string(100, 'a') };
+        REQUIRE_EQ(heap.size(), 100);
+        REQUIRE_GE(heap.capacity(), 100);
+        heap.resize(3);
+        REQUIRE_EQ(heap, "aaa");
+        REQUIRE_EQ(std::hash<sso::small_string<63>>{}(heap), std::hash<std::string_view>{}("aaa"));
+        REQUIRE_EQ(sso::fast_hash{}(sso::small_string<63>{ sv }), sso::fast_hash{}(sv));
+        REQUIRE_EQ(sso::fast_hash{}(sso::small_string<63>{ "abc" }), sso::fast_hash{}("abc"));
+    }
+
     TEST_CASE("move c-tor")
     {
         std::string_view const _123{ "123" };
@@ -191,6 +558,503 @@ TEST_SUITE("sso")
         REQUIRE_EQ(s, _123);
     }
 
+    TEST_CASE("move steals buffer")
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("c-tor")
+        {
+            sso::string s{ long_str };
+            auto const* const data{ s.data() };
+
+            sso::string moved{ std::move(s) };
+            REQUIRE_EQ(moved.data(), data);
+            REQUIRE_EQ(moved, long_str);
+            REQUIRE(s.empty());
+            REQUIRE_EQ(std::strcmp(s.c_str(), ""), 0);
+        }
+        SUBCASE("assignment")
+        {
+            sso::string s{ long_str };
+            auto const* const data{ s.data() };
+
+            sso::string moved{ "123" };
+            moved = std::move(s);
+            REQUIRE_EQ(moved.data(), data);
+            REQUIRE_EQ(moved, long_str);
+            REQUIRE(s.empty());
+
+            s = std::move(moved);
+            REQUIRE_EQ(s.data(), data);
+            REQUIRE(moved.empty());
+        }
+        SUBCASE("short")
+        {
+            sso::string s{ "123" };
+            sso::string moved;
+            moved = std::move(s);
+            REQUIRE_EQ(moved, "123");
+            REQUIRE(s.empty());
+        }
+        SUBCASE("unequal allocators")
+        {
+            using string = sso::basic_string<char, std::pmr::polymorphic_allocator<char>>;
+
+            std::pmr::monotonic_buffer_resource resource;
+            string s{ long_str };
+            string moved{ &resource };
+            moved = std::move(s);
+            REQUIRE_EQ(moved, long_str);
+            REQUIRE_EQ(moved.get_allocator().resource(), &resource);
+            REQUIRE(s.empty());
+        }
+
+        REQUIRE(std::is_nothrow_move_constructible_v<sso::string>);
+        REQUIRE(std::is_nothrow_move_assignable_v<sso::string>);
+    }
+
+    TEST_CASE("copy-on-write")
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("copy shares heap buffer until mutable access")
+        {
+            sso::shared_string s{ long_str };
+            sso::shared_string copy{ s };
+            REQUIRE_EQ(std::as_const(copy).data(), std::as_const(s).data());
+
+            copy[0] = 'T';
+            REQUIRE_NE(std::as_const(copy).data(), std::as_const(s).data());
+            REQUIRE_EQ(s, long_str);
+            REQUIRE_EQ(copy.substr(1, long_str.size() - 1), long_str.substr(1));
+            REQUIRE_EQ(copy.front(), 'T');
+
+            // `copy` is the only owner now
+            auto const* const data{ copy.data() };
+            copy[1] = 'H';
+            REQUIRE_EQ(copy.data(), data);
+        }
+        SUBCASE("copy after mutable access doesn't share")
+        {
+            sso::shared_string s{ long_str };
+            auto& reference{ s[0] };
+            auto* const pointer{ s.data() + 1 };
+
+            auto const copy{ s };
+            sso::shared_string assigned;
+            assigned = s;
+            REQUIRE_NE(copy.data(), std::as_const(s).data());
+            REQUIRE_NE(assigned.data(), std::as_const(s).data());
+
+            reference = 'T';
+            *pointer = 'H';
+            REQUIRE_EQ(copy, long_str);
+            REQUIRE_EQ(assigned, long_str);
+            REQUIRE_EQ(s.substr(0, 4), "THis");
+
+            // reallocation invalidates references, so new buffer is shareable again
+            s.append(long_str);
+            sso::shared_string const shared{ s };
+            REQUIRE_EQ(shared.data(), std::as_const(s).data());
+        }
+        SUBCASE("concatenation result is shareable")
+        {
+            std::string_view const prefix{ "> " };
+            sso::shared_string const short_prefix{ prefix };
+            auto const make{ [&] {
+                sso::shared_string s{ long_str };
+                s.reserve(long_str.size() + prefix.size());
+                return s;
+            } };
+
+            for (auto const& result :
+                 { prefix + make(), short_prefix + make(), sso::shared_string{ short_prefix } + make() })
+            {
+                REQUIRE_EQ(result.substr(prefix.size()), long_str);
+
+                auto const copy{ result };
+                REQUIRE_EQ(copy.data(), result.data());
+            }
+        }
+        SUBCASE("copy assignment")
+        {
+            sso::shared_string copy{ "short" };
+            {
+                sso::shared_string const s{ long_str };
+                copy = s;
+                REQUIRE_EQ(std::as_const(copy).data(), s.data());
+
+                sso::shared_string another{ long_str };
+                another = copy;
+                REQUIRE_EQ(std::as_const(another).data(), s.data());
+            }
+            REQUIRE_EQ(copy, long_str);
+        }
+        SUBCASE("modifiers detach")
+        {
+            sso::shared_string s{ long_str };
+
+            sso::shared_string appended{ s };
+            appended.append("!");
+            REQUIRE_EQ(appended.size(), long_str.size() + 1);
+
+            sso::shared_string erased{ s };
+            erased.erase(erased.cbegin(), erased.cbegin() + 5);
+            REQUIRE_EQ(erased, long_str.substr(5));
+
+            sso::shared_string popped{ s };
+            popped.pop_back();
+            REQUIRE_EQ(popped, long_str.substr(0, long_str.size() - 1));
+
+            sso::shared_string resized{ s };
+            resized.resize(4);
+            REQUIRE_EQ(resized, "this");
+
+            sso::shared_string cleared{ s };
+            cleared.clear();
+            REQUIRE(cleared.empty());
+            REQUIRE_EQ(std::strcmp(cleared.c_str(), ""), 0);
+
+            REQUIRE_EQ(s, long_str);
+            REQUIRE_EQ(std::strlen(s.c_str()), long_str.size());
+        }
+        SUBCASE("short strings are copied")
+        {
+            sso::shared_string const s{ "short" };
+            sso::shared_string const copy{ s };
+            REQUIRE_NE(copy.data(), s.data());
+            REQUIRE_EQ(copy, s);
+        }
+        SUBCASE("unique ownership copies")
+        {
+            sso::string const s{ long_str };
+            sso::string const copy{ s };
+            REQUIRE_NE(copy.data(), s.data());
+            REQUIRE_EQ(copy, s);
+        }
+        SUBCASE("unequal allocators copy")
+        {
+            using string = sso::basic_string<char, std::pmr::polymorphic_allocator<char>, sso::geometric_growth,
+                                             0, sso::shared_ownership>;
+
+            std::pmr::monotonic_buffer_resource resource;
+            string const s{ long_str };
+
+            string other{ &resource };
+            other = s;
+            REQUIRE_NE(other.data(), s.data());
+            REQUIRE_EQ(other, s);
+
+            string same{ std::pmr::get_default_resource() };
+            same = s;
+            REQUIRE_EQ(std::as_const(same).data(), s.data());
+        }
+
+        REQUIRE(noexcept(std::declval<sso::string&>().data()));
+        REQUIRE(!noexcept(std::declval<sso::shared_string&>().data()));
+        REQUIRE(std::is_nothrow_move_constructible_v<sso::shared_string>);
+    }
+
+    TEST_CASE("static storage")
+    {
+        using string = sso::basic_string<char, std::pmr::polymorphic_allocator<char>, sso::geometric_growth, 0,
+                                         sso::shared_ownership>;
+
+        static constexpr std::string_view long_str{ "this string is too long for small buffer" };
+        tracking_resource resource;
+
+        SUBCASE("refers to static storage until mutable access")
+        {
+            string s{ sso::static_storage, long_str, &resource };
+            REQUIRE_EQ(std::as_const(s).data(), long_str.data());
+            REQUIRE_EQ(s, long_str);
+            REQUIRE_EQ(s.capacity(), long_str.size());
+            REQUIRE_EQ(std::hash<string>{}(s), std::hash<std::string_view>{}(long_str));
+
+            string copy{ s };
+            REQUIRE_EQ(std::as_const(copy).data(), long_str.data());
+            REQUIRE_EQ(resource.outstanding, 0);
+
+            copy[0] = 'T';
+            REQUIRE_NE(std::as_const(copy).data(), long_str.data());
+            REQUIRE_EQ(copy.substr(1, long_str.size() - 1), long_str.substr(1));
+            REQUIRE_EQ(std::as_const(s).data(), long_str.data());
+
+            s.data()[0] = 'T';
+            REQUIRE_GT(resource.outstanding, 0);
+            REQUIRE_EQ(s, copy);
+            REQUIRE_EQ(long_str.front(), 't');
+        }
+        SUBCASE("modifiers copy")
+        {
+            string const s{ sso::static_storage, long_str, &resource };
+
+            string appended{ s };
+            appended.append("!");
+            REQUIRE_EQ(appended.size(), long_str.size() + 1);
+
+            string resized{ s };
+            resized.resize(4);
+            REQUIRE_EQ(resized, "this");
+
+            string converted{ s };
+            converted.to_upper();
+            REQUIRE_EQ(converted.substr(0, 4), "THIS");
+
+            string cleared{ s };
+            cleared.clear();
+            REQUIRE(cleared.empty());
+
+            string assigned{ &resource };
+            assigned.append("another string, which is long too");
+            assigned = s;
+            REQUIRE_EQ(std::as_const(assigned).data(), long_str.data());
+
+            REQUIRE_EQ(s, long_str);
+            REQUIRE_EQ(std::as_const(s).data(), long_str.data());
+        }
+        SUBCASE("short result doesn't allocate")
+        {
+            string assigned{ sso::static_storage, long_str, &resource };
+            assigned = std::string_view{ "hi" };
+            REQUIRE_EQ(assigned, "hi");
+            REQUIRE(assigned.get_allocator().resource() == &resource);
+            REQUIRE_EQ(resource.outstanding, 0);
+
+            string shortened{ sso::static_storage, long_str, &resource };
+            shortened.resize(4);
+            shortened.erase(shortened.cbegin());
+            REQUIRE_EQ(shortened, "his");
+            REQUIRE_EQ(resource.outstanding, 0);
+
+            string owner{ &resource };
+            owner.append(long_str);
+            auto const outstanding{ resource.outstanding };
+            string copy{ &resource };
+            copy = owner;
+            REQUIRE_EQ(std::as_const(copy).data(), std::as_const(owner).data());
+            copy = std::string_view{ "hi" };
+            REQUIRE_EQ(copy, "hi");
+            REQUIRE_EQ(resource.outstanding, outstanding);
+            REQUIRE_EQ(owner, long_str);
+
+            // longer result is allocated with exact size instead of capacity of shared buffer
+            string appended{ &resource };
+            appended = owner;
+            appended.replace(0, long_str.size(), std::string_view{ "string, which is longer than inline one" });
+            REQUIRE_EQ(appended.capacity(), 39);
+        }
+        SUBCASE("short string is inline")
+        {
+            sso::shared_string const s{ sso::static_storage, "short" };
+            REQUIRE_EQ(s, "short");
+            REQUIRE_EQ(s.capacity(), sso::shared_string::inline_capacity());
+        }
+        REQUIRE_EQ(resource.outstanding, 0);
+    }
+
+    TEST_CASE_TEMPLATE("relocate", string_type, sso::string, sso::shared_string, sso::small_string<63>, std::string)
+    {
+        static_assert(sso::is_trivially_relocatable_v<string_type> == !std::is_same_v<string_type, std::string>);
+        static_assert(sso::is_trivially_relocatable_v<sso::pmr::string>);
+        static_assert(sso::is_trivially_relocatable_v<sso::arena_string>);
+        static_assert(sso::is_trivially_relocatable_v<sso::interned_string>);
+
+        std::string_view const long_str{ "this string is too long for any small buffer of this test, even for the one of 63 chars" };
+        std::allocator<string_type> allocator;
+
+        auto* const first{ allocator.allocate(3) };
+        std::construct_at(first, "short");
+        std::construct_at(first + 1, long_str);
+        std::construct_at(first + 2);
+        auto const* const long_data{ std::as_const(first[1]).data() };
+
+        // storage of grown container
+        auto* const second{ allocator.allocate(4) };
+        REQUIRE_EQ(sso::uninitialized_relocate(first, first + 3, second), second + 3);
+        allocator.deallocate(first, 3);
+
+        REQUIRE_EQ(second[0], "short");
+        REQUIRE_EQ(second[1], long_str);
+        REQUIRE(second[2].empty());
+        // heap buffer is taken as is
+        REQUIRE_EQ(std::as_const(second[1]).data(), long_data);
+
+        second[0].append(" string");
+        REQUIRE_EQ(second[0], "short string");
+
+        REQUIRE_EQ(sso::relocate_at(second + 1, second + 3), second + 3);
+        REQUIRE_EQ(second[3], long_str);
+        std::construct_at(second + 1, second[3]);
+        REQUIRE_EQ(second[1], second[3]);
+
+        std::destroy(second, second + 4);
+        allocator.deallocate(second, 4);
+    }
+
+    TEST_CASE("string table")
+    {
+        static_assert(std::ranges::random_access_range<sso::string_table>);
+
+        std::string_view const long_str{ "this string is too long for small buffer" };
+        sso::string_table table;
+        REQUIRE(table.empty());
+
+        auto const b{ table.push_back("b") };
+        auto const long_handle{ table.push_back(long_str) };
+        table.push_back(sso::string{ "" });
+        table.push_back(std::string{ "b" });
+        table.push_back("a");
+
+        REQUIRE_EQ(table.size(), 5);
+        REQUIRE_EQ(table[b], "b");
+        REQUIRE_EQ(table[long_handle], long_str);
+        REQUIRE_EQ(std::strlen(table.c_str(long_handle)), long_str.size());
+        REQUIRE(table[2].empty());
+        REQUIRE_EQ(table.chars_size(), 1 + long_str.size() + 0 + 1 + 1 + table.size());
+        REQUIRE_EQ(std::ranges::count(table, "b"), 2);
+
+        SUBCASE("push_back of own string")
+        {
+            for (int i{ 0 }; i < 20; ++i) table.push_back(table[long_handle]);
+            table.push_back(*table.begin());
+            table.push_back(table[long_handle].substr(5, 6));
+
+            REQUIRE_EQ(table.size(), 5 + 20 + 2);
+            REQUIRE(std::ranges::all_of(std::views::drop(table, 5) | std::views::take(20),
+                                        [&](auto str) { return str == long_str; }));
+            REQUIRE_EQ(table[25], "b");
+            REQUIRE_EQ(table[26], "string");
+        }
+        SUBCASE("conversion")
+        {
+            std::vector<sso::string> const strings(table.begin(), table.end());
+            REQUIRE_EQ(strings.size(), table.size());
+            REQUIRE_EQ(strings[1], long_str);
+
+            sso::string_table const copy{ strings };
+            REQUIRE_EQ(copy, table);
+        }
+        SUBCASE("sort")
+        {
+            table.sort();
+            REQUIRE(std::ranges::is_sorted(table));
+            REQUIRE_EQ(table[0], "");
+            REQUIRE_EQ(table[4], long_str);
+
+            table.sort(std::ranges::greater{});
+            REQUIRE_EQ(table[0], long_str);
+        }
+        SUBCASE("deduplicate")
+        {
+            auto const handles{ table.deduplicate() };
+            REQUIRE_EQ(table.size(), 4);
+            REQUIRE_EQ(handles.size(), 5);
+            REQUIRE_EQ(handles[0], handles[3]);
+            REQUIRE_EQ(table[handles[3]], "b");
+            REQUIRE_EQ(table[handles[4]], "a");
+            REQUIRE_EQ(table[handles[1]], long_str);
+        }
+        SUBCASE("allocator")
+        {
+            tracking_resource resource;
+            {
+                sso::pmr::string_table pmr_table{ table, &resource };
+                REQUIRE_GT(resource.outstanding, 0);
+                pmr_table.sort();
+                pmr_table.deduplicate();
+                REQUIRE_EQ(pmr_table.get_allocator().resource(), &resource);
+            }
+            REQUIRE_EQ(resource.outstanding, 0);
+        }
+
+        table.clear();
+        REQUIRE(table.empty());
+        REQUIRE_EQ(table.begin(), table.end());
+    }
+
+    TEST_CASE("string builder")
+    {
+        std::string const long_str{ "this string is too long for small buffer" };
+        std::string expected;
+
+        sso::string_builder builder{ 64 };
+        REQUIRE(builder.empty());
+        for (int i{ 0 }; i < 10; ++i)
+        {
+            builder += std::to_string(i);
+            builder += ',';
+            expected += std::to_string(i) + ',';
+        }
+        REQUIRE_EQ(builder.chunk_count(), 1);
+
+        sso::string moved{ long_str + long_str };
+        auto const* const moved_data{ moved.data() };
+        builder.append(std::move(moved)).append(sso::string{ "!" });
+        expected += long_str + long_str + "!";
+        REQUIRE_EQ(builder.chunk_count(), 3);
+        REQUIRE_EQ((*std::ranges::next(builder.chunks().begin())).data(), moved_data);
+
+        builder.append(std::string(100, 'x'));
+        expected += std::string(100, 'x');
+        REQUIRE_EQ(builder.size(), expected.size());
+
+        std::string joined;
+        for (auto const chunk : builder.chunks()) joined += chunk;
+        REQUIRE_EQ(joined, expected);
+
+        SUBCASE("str")
+        {
+            auto const str{ builder.str() };
+            REQUIRE_EQ(str, expected);
+            REQUIRE_EQ(str.capacity(), expected.size());
+
+            REQUIRE_EQ(std::move(builder).str(), expected);
+            REQUIRE(builder.empty());
+
+            sso::string single{ long_str };
+            auto const* const data{ single.data() };
+            builder += std::move(single);
+            REQUIRE_EQ(std::move(builder).str().data(), data);
+        }
+        SUBCASE("consume")
+        {
+            builder.consume(5);
+            REQUIRE_EQ(builder.str(), expected.substr(5));
+            builder.consume(builder.chunks().front().size() + 10);
+            REQUIRE_EQ(builder.str(), expected.substr(20 + 10));
+            builder.consume(builder.size());
+            REQUIRE(builder.empty());
+            REQUIRE_EQ(builder.chunk_count(), 0);
+        }
+#if __has_include(<sys/uio.h>)
+        SUBCASE("iovec")
+        {
+            std::array<iovec, 2> iovecs{};
+            REQUIRE_EQ(builder.to_iovec(iovecs), 2);
+            REQUIRE_EQ(std::string_view(static_cast<char const*>(iovecs[0].iov_base), iovecs[0].iov_len),
+                       builder.chunks().front());
+            REQUIRE_EQ(iovecs[1].iov_len, 2 * long_str.size());
+
+            builder.consume(iovecs[0].iov_len + iovecs[1].iov_len);
+            REQUIRE_EQ(builder.str(), "!" + std::string(100, 'x'));
+        }
+#endif
+        SUBCASE("allocator")
+        {
+            tracking_resource resource;
+            {
+                sso::pmr::string_builder pmr_builder{ &resource };
+                sso::pmr::string moved{ &resource };
+                moved.append(long_str);
+                pmr_builder.append(long_str).append(std::move(moved));
+                REQUIRE_EQ(pmr_builder.chunk_count(), 1);
+                REQUIRE_EQ(pmr_builder.str().get_allocator().resource(), &resource);
+            }
+            REQUIRE_EQ(resource.outstanding, 0);
+        }
+    }
+
     TEST_CASE_TEMPLATE("sso", CharType, char, char8_t, char16_t, char32_t, wchar_t)
     {
         using string = sso::basic_string<CharType, std::pmr::polymorphic_allocator<CharType>>;
@@ -214,6 +1078,32 @@ TEST_SUITE("sso")
         REQUIRE_GE(s.capacity(), capacity);
     }
 
+    TEST_CASE("growth policy")
+    {
+        using size_type = sso::string::size_type;
+
+        SUBCASE("geometric")
+        {
+            sso::string s;
+            size_type reallocations{ 0 };
+            for (size_type i{ 0 }; i < 1000; ++i)
+            {
+                auto const capacity{ s.capacity() };
+                s.push_back('x');
+                if (s.capacity() != capacity) ++reallocations;
+            }
+            REQUIRE_EQ(s.size(), 1000);
+            REQUIRE_LE(reallocations, 10);
+        }
+        SUBCASE("exact")
+        {
+            sso::basic_string<char, std::allocator<char>, sso::exact_growth> s;
+            for (size_type i{ 0 }; i < 100; ++i) s.push_back('x');
+            REQUIRE_EQ(s.size(), 100);
+            REQUIRE_EQ(s.capacity(), s.size());
+        }
+    }
+
     TEST_CASE("replace")
     {
         std::string_view const _123{ "123" };
@@ -249,6 +1139,55 @@ TEST_SUITE("sso")
         }
     }
 
+    TEST_CASE("replace with overlapping source")
+    {
+        std::string_view const init{ "0123456789" };
+        for (std::size_t length : { init.size(), std::size_t{ 40 } })
+        {
+            std::string model;
+            while (model.size() < length) model += init;
+            model.resize(length);
+
+            for (std::size_t pos{ 0 }; pos <= model.size(); pos += 3)
+            {
+                for (std::size_t count{ 0 }; pos + count <= model.size(); count += 4)
+                {
+                    for (std::size_t src_pos{ 0 }; src_pos <= model.size(); src_pos += 5)
+                    {
+                        for (std::size_t src_size{ 0 }; src_pos + src_size <= model.size(); src_size += 6)
+                        {
+                            std::string expected{ model };
+                            expected.replace(pos, count, model.substr(src_pos, src_size));
+
+                            // in-place
+                            sso::string s{ model };
+                            s.reserve(2 * model.size());
+                            s.replace(pos, count, std::string_view{ s }.substr(src_pos, src_size));
+                            REQUIRE_EQ(s, expected);
+
+                            // with reallocation, if grows
+                            sso::string t{ model };
+                            t.replace(pos, count, std::string_view{ t }.substr(src_pos, src_size));
+                            REQUIRE_EQ(t, expected);
+                        }
+                    }
+                }
+            }
+        }
+
+        {
+            sso::string s{ "0123456789abcdefghijklmnopqrstuvwxyz" };
+            std::string std{ s };
+            s.append(s);
+            std.append(std);
+            REQUIRE_EQ(s, std);
+
+            s.replace(0, 1, s);
+            std.replace(0, 1, std);
+            REQUIRE_EQ(s, std);
+        }
+    }
+
     TEST_CASE("assign")
     {
         char const* const s_123{ "123" };
@@ -357,6 +1296,45 @@ TEST_SUITE("sso")
         REQUIRE_EQ(std + sso.c_str(), sso + std);
     }
 
+    TEST_CASE("operator+ reuses rvalue buffer")
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+        std::string const std{ long_str };
+
+        {
+            sso::string s{ long_str };
+            s.reserve(3 * long_str.size());
+            auto const* const data{ s.data() };
+            auto const result{ std::move(s) + long_str };
+            REQUIRE_EQ(result.data(), data);
+            REQUIRE_EQ(result, std + std);
+        }
+        {
+            sso::string s{ long_str };
+            s.reserve(3 * long_str.size());
+            auto const* const data{ s.data() };
+            auto const result{ long_str + std::move(s) };
+            REQUIRE_EQ(result.data(), data);
+            REQUIRE_EQ(result, std + std);
+        }
+        {
+            sso::string l{ long_str };
+            sso::string r{ long_str };
+            r.reserve(3 * long_str.size());
+            auto const* const data{ r.data() };
+            auto const result{ std::move(l) + std::move(r) };
+            REQUIRE_EQ(result.data(), data);
+            REQUIRE_EQ(result, std + std);
+        }
+        {
+            sso::string const l{ "123" };
+            REQUIRE_EQ(l + l, "123123");
+            REQUIRE_EQ(std::string_view{ "0" } + l, "0123");
+            REQUIRE_EQ(l + sso::string{ "4" }, "1234");
+            REQUIRE_EQ(sso::string{ "0" } + l, "0123");
+        }
+    }
+
     TEST_CASE("operator+=")
     {
         std::string const s123{ "123" };
@@ -410,6 +1388,240 @@ TEST_SUITE("sso")
         }
     }
 
+    TEST_CASE("compare short strings by words")
+    {
+        std::vector<std::string> values{ "", "a", std::string("a\0", 2), std::string(1, '\xff'), "ab", "b",
+                                         "abcdefghijklmnopqrstuvw", "abcdefghijklmnopqrstuv",
+                                         "abcdefghijklmnopqrstuvx", "abcdefgh", "abcdefgh\x80" };
+        values.emplace_back(3, '\0');
+        values.emplace_back(23, '\xff');
+        values.emplace_back("this string is too long for small buffer");
+
+        for (auto const& l : values)
+        {
+            for (auto const& r : values)
+            {
+                sso::string const sso_l{ l };
+                sso::string const sso_r{ r };
+                REQUIRE_EQ(sso_l == sso_r, l == r);
+                REQUIRE_EQ(sso_l <=> sso_r, l <=> r);
+
+                // same content after shrink, bytes after length must not affect result
+                sso::string shrunk{ r + "garbage" };
+                shrunk.resize(r.size());
+                REQUIRE_EQ(sso_l == shrunk, l == r);
+                REQUIRE_EQ(sso_l <=> shrunk, l <=> r);
+            }
+        }
+
+        // same content in short and long representation
+        sso::string long_repr{ "this string is too long for small buffer" };
+        long_repr.resize(3);
+        REQUIRE_EQ(long_repr, sso::string{ "thi" });
+        REQUIRE_EQ(long_repr <=> sso::string{ "thi" }, std::strong_ordering::equal);
+    }
+
+    TEST_CASE("heterogeneous compare")
+    {
+        sso::string const s{ "123" };
+        std::string_view const sv{ "124" };
+        char const* const c_str{ "122" };
+
+        REQUIRE_LT(s, sv);
+        REQUIRE_GT(sv, s);
+        REQUIRE_GT(s, c_str);
+        REQUIRE_LT(c_str, s);
+        REQUIRE_EQ(s, "123");
+        REQUIRE_EQ("123", s);
+        REQUIRE_NE(s, c_str);
+        REQUIRE_EQ(s <=> std::string_view{ "123" }, std::strong_ordering::equal);
+    }
+
+    TEST_CASE("sort doesn't allocate")
+    {
+        struct counting_resource : std::pmr::memory_resource
+        {
+            std::size_t allocations{ 0 };
+
+            void*
+            do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                ++allocations;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void
+            do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            bool
+            do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+        using string = sso::basic_string<char, std::pmr::polymorphic_allocator<char>>;
+
+        counting_resource resource;
+        std::vector<string> strings;
+        strings.reserve(100);
+        for (int i{ 0 }; i < 100; ++i)
+        {
+            auto const value{ std::to_string((i * 7919) % 100) };
+            strings.emplace_back(&resource).append(value + std::string(i % 2 == 0 ? 0 : 30, 'x'));
+        }
+
+        auto const allocations{ resource.allocations };
+        std::ranges::sort(strings);
+        REQUIRE(std::ranges::is_sorted(strings));
+        REQUIRE_EQ(resource.allocations, allocations);
+    }
+
+    TEST_CASE("hash")
+    {
+        std::string_view const short_str{ "123" };
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        for (auto const sv : { std::string_view{}, short_str, long_str })
+        {
+            sso::string const s{ sv };
+            REQUIRE_EQ(std::hash<sso::string>{}(s), std::hash<std::string_view>{}(sv));
+            REQUIRE_EQ(sso::string_hash{}(s), std::hash<std::string_view>{}(sv));
+            REQUIRE_EQ(sso::fast_hash{}(s), sso::fast_hash{}(sv));
+        }
+
+        // short content in long representation
+        sso::string s{ long_str };
+        s.resize(short_str.size());
+        s.replace(0, s.size(), short_str);
+        REQUIRE_EQ(sso::fast_hash{}(s), sso::fast_hash{}(short_str));
+        REQUIRE_EQ(sso::fast_hash{}(s), sso::fast_hash{}(sso::string{ short_str }));
+        REQUIRE_EQ(sso::fast_hash{}(s), sso::fast_hash{}("123"));
+
+        // garbage after length in inline buffer isn't hashed
+        sso::string garbage{ "12345678901234567890" };
+        garbage.resize(3);
+        REQUIRE_EQ(sso::fast_hash{}(garbage), sso::fast_hash{}(short_str));
+
+        REQUIRE_NE(sso::fast_hash{}(std::string_view{ "1" }), sso::fast_hash{}(std::string_view{ "2" }));
+        REQUIRE_NE(sso::fast_hash{}(std::string_view{ "" }), sso::fast_hash{}(std::string_view{ "\0", 1 }));
+
+        std::unordered_set<std::size_t> hashes;
+        for (int i{ 0 }; i < 1000; ++i)
+        {
+            hashes.insert(sso::fast_hash{}(sso::string{ std::to_string(i) }));
+            hashes.insert(sso::fast_hash{}(sso::string{ long_str } + std::to_string(i)));
+        }
+        REQUIRE_EQ(hashes.size(), 2000);
+    }
+
+    TEST_CASE("heterogeneous lookup")
+    {
+        std::unordered_map<sso::string, int, sso::string_hash, sso::string_equal> map;
+        map.emplace(sso::string{ "123" }, 1);
+        map.emplace(sso::string{ "this string is too long for small buffer" }, 2);
+
+        REQUIRE_EQ(map.find(std::string_view{ "123" })->second, 1);
+        REQUIRE_EQ(map.find("this string is too long for small buffer")->second, 2);
+        REQUIRE(map.find(std::string_view{ "1234" }) == map.end());
+
+        std::unordered_set<sso::string, sso::fast_hash, sso::string_equal> set;
+        set.emplace("123");
+        REQUIRE(set.contains(std::string_view{ "123" }));
+        REQUIRE(set.contains("123"));
+        REQUIRE_FALSE(set.contains("12"));
+    }
+
+    TEST_CASE("interned string")
+    {
+        std::string const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("short strings are inline")
+        {
+            sso::arena_intern_pool pool;
+            auto const s{ pool.intern("tag") };
+            REQUIRE(s.is_inline());
+            REQUIRE_EQ(s, std::string_view{ "tag" });
+            REQUIRE_EQ(s, pool.intern("tag"));
+            REQUIRE_NE(s, pool.intern("tab"));
+            REQUIRE_EQ(pool.size(), 0);
+            REQUIRE(sso::interned_string{}.empty());
+        }
+        SUBCASE("long strings are deduplicated")
+        {
+            sso::arena_intern_pool pool;
+            auto const s{ pool.intern(long_str) };
+            auto const copy{ pool.intern(std::string{ long_str }) };
+            REQUIRE_FALSE(s.is_inline());
+            REQUIRE_EQ(s.data(), copy.data());
+            REQUIRE_EQ(s, copy);
+            REQUIRE_EQ(std::strcmp(s.c_str(), long_str.c_str()), 0);
+            REQUIRE_EQ(pool.size(), 1);
+
+            auto const other{ pool.intern(long_str + "!") };
+            REQUIRE_NE(s, other);
+            REQUIRE_LT(s, other);
+            REQUIRE_EQ(pool.size(), 2);
+
+            pool.release();
+            REQUIRE_EQ(pool.size(), 0);
+        }
+        SUBCASE("different pools")
+        {
+            sso::arena_intern_pool pool1;
+            sso::arena_intern_pool pool2;
+            REQUIRE_EQ(pool1.intern(long_str), pool2.intern(long_str));
+            REQUIRE_NE(pool1.intern(long_str), pool2.intern(long_str + "!"));
+        }
+        SUBCASE("hash")
+        {
+            auto& pool{ sso::global_intern_pool() };
+            for (std::string_view const value : { std::string_view{ "tag" }, std::string_view{ long_str } })
+            {
+                auto const s{ pool.intern(value) };
+                REQUIRE_EQ(s.hash(), sso::fast_hash{}(value));
+                REQUIRE_EQ(std::hash<sso::interned_string>{}(s), sso::fast_hash{}(value));
+            }
+
+            std::unordered_set<sso::interned_string> set;
+            set.insert(pool.intern(long_str));
+            set.insert(pool.intern("tag"));
+            REQUIRE(set.contains(pool.intern(long_str)));
+            REQUIRE_FALSE(set.contains(pool.intern("tab")));
+        }
+        SUBCASE("concurrent interning")
+        {
+            sso::intern_pool pool;
+            std::vector<std::string> values;
+            for (int i{ 0 }; i < 100; ++i) values.push_back(long_str + std::to_string(i));
+
+            std::vector<std::vector<sso::interned_string>> results(4);
+            {
+                std::vector<std::jthread> threads;
+                for (auto& result : results)
+                {
+                    threads.emplace_back(
+                        [&]
+                        {
+                            for (auto const& value : values) result.push_back(pool.intern(value));
+                        });
+                }
+            }
+
+            REQUIRE_EQ(pool.size(), values.size());
+            for (auto const& result : results)
+            {
+                for (std::size_t i{ 0 }; i < values.size(); ++i)
+                {
+                    REQUIRE_EQ(result[i].data(), results.front()[i].data());
+                    REQUIRE_EQ(result[i], std::string_view{ values[i] });
+                }
+            }
+        }
+    }
+
     TEST_CASE("starts_with")
     {
         sso::string s1{ "1" };
@@ -454,6 +1666,165 @@ TEST_SUITE("sso")
     }
 #endif
 
+    TEST_CASE_TEMPLATE("find", string_type, sso::string, sso::small_string<63>)
+    {
+        // lengths cover short strings, tails of SSE2 and AVX2 blocks
+        for (std::size_t length : { 0, 1, 7, 15, 16, 17, 23, 31, 32, 33, 63, 64, 100 })
+        {
+            std::string expected;
+            for (std::size_t i{ 0 }; i < length; ++i) expected.push_back(static_cast<char>('a' + i * 7 % 26));
+            string_type const str{ std::string_view{ expected } };
+            std::string_view const view{ expected };
+
+            for (std::size_t pos : { std::size_t{ 0 }, std::size_t{ 1 }, length / 2, length, length + 1,
+                                     string_type::npos })
+            {
+                for (std::string_view needle :
+                     { std::string_view{ "" }, { "a" }, { "ah" }, { "hov" }, { "zz" }, { "\0", 1 } })
+                {
+                    REQUIRE_EQ(str.find(needle, pos), view.find(needle, pos));
+                    REQUIRE_EQ(str.rfind(needle, pos), view.rfind(needle, pos));
+                }
+
+                for (char c : { 'a', 'h', 'z', '\0' })
+                {
+                    REQUIRE_EQ(str.find(c, pos), view.find(c, pos));
+                    REQUIRE_EQ(str.rfind(c, pos), view.rfind(c, pos));
+                    REQUIRE_EQ(str.find_first_not_of(c, pos), view.find_first_not_of(c, pos));
+                    REQUIRE_EQ(str.find_last_not_of(c, pos), view.find_last_not_of(c, pos));
+                }
+
+                // the last set doesn't fit into vector registers
+                for (std::string_view set : { "", "z", "hov", "abcdefghijklm", "abcdefghijklmnopqrstuvwxy" })
+                {
+                    REQUIRE_EQ(str.find_first_of(set, pos), view.find_first_of(set, pos));
+                    REQUIRE_EQ(str.find_last_of(set, pos), view.find_last_of(set, pos));
+                    REQUIRE_EQ(str.find_first_not_of(set, pos), view.find_first_not_of(set, pos));
+                    REQUIRE_EQ(str.find_last_not_of(set, pos), view.find_last_not_of(set, pos));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("find in tokens")
+    {
+        sso::string const line{ "key = \"value\", other_key = 42 # comment\n" };
+        REQUIRE_EQ(line.find_first_of("=\"#"), 4);
+        REQUIRE_EQ(line.find_first_not_of(" \t", 5), 6);
+        REQUIRE_EQ(line.find_last_of(",="), 25);
+        REQUIRE_EQ(line.find_last_not_of(" \n"), 38);
+        REQUIRE_EQ(line.find("comment"), 32);
+        REQUIRE_EQ(line.find("comments"), sso::string::npos);
+
+        sso::string const word{ "token" };
+        REQUIRE_LE(word.size(), sso::string::inline_capacity());
+        REQUIRE_EQ(word.find_first_of("nk"), 2);
+        REQUIRE_EQ(word.find_last_of("nk"), 4);
+        REQUIRE_EQ(word.find_first_of(" "), sso::string::npos);
+        REQUIRE_EQ(word.find_first_not_of("kot"), 3);
+    }
+
+    TEST_CASE_TEMPLATE("case conversion", string_type, sso::string, sso::small_string<100>, sso::shared_string)
+    {
+        // lengths cover words, SSE2 and AVX2 blocks and their tails, bytes >= 0x80 are kept
+        for (std::size_t length : { 0, 1, 7, 8, 15, 16, 23, 24, 31, 32, 33, 64, 99, 100, 101, 257 })
+        {
+            std::string source;
+            for (std::size_t i{ 0 }; i < length; ++i) source.push_back(static_cast<char>(i * 37 % 256));
+
+            std::string lower{ source };
+            std::string upper{ source };
+            for (auto& c : lower) c = 'A' <= c && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+            for (auto& c : upper) c = 'a' <= c && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+
+            string_type str{ std::string_view{ source } };
+            auto const copy{ str };
+            REQUIRE_EQ(str.to_lower(), std::string_view{ lower });
+            REQUIRE_EQ(str.size(), length);
+            REQUIRE_EQ(str.to_upper(), std::string_view{ upper });
+            REQUIRE_EQ(copy, std::string_view{ source });
+
+            REQUIRE(sso::iequals(str, copy));
+            REQUIRE(sso::iequals(str, std::string_view{ lower }));
+            REQUIRE_EQ(sso::icompare(str, copy), std::weak_ordering::equivalent);
+            REQUIRE_EQ(sso::case_insensitive_hash{}(str), sso::case_insensitive_hash{}(copy));
+            REQUIRE_EQ(sso::case_insensitive_hash{}(str), sso::case_insensitive_hash{}(std::string_view{ lower }));
+            REQUIRE_EQ(sso::case_insensitive_hash{}(str), sso::fast_hash{}(std::string_view{ lower }));
+        }
+    }
+
+    TEST_CASE("case-insensitive compare")
+    {
+        std::string_view const long_str{ "Content-Type: text/html; charset=UTF-8; boundary=something" };
+        for (auto const size : { std::size_t{ 5 }, std::size_t{ 12 }, long_str.size() })
+        {
+            auto const view{ long_str.substr(0, size) };
+            sso::string const str{ view };
+            for (std::size_t i{ 0 }; i < size; ++i)
+            {
+                // differs in one position only
+                std::string other{ view };
+                other[i] = '~';
+                sso::string const different{ std::string_view{ other } };
+                REQUIRE_FALSE(sso::iequals(str, different));
+                REQUIRE_EQ(sso::icompare(str, different), std::weak_ordering::less);
+                REQUIRE_EQ(sso::icompare(different, str), std::weak_ordering::greater);
+            }
+
+            sso::string const shorter{ view.substr(0, size - 1) };
+            REQUIRE_FALSE(sso::iequals(str, shorter));
+            REQUIRE_EQ(sso::icompare(shorter, str), std::weak_ordering::less);
+        }
+
+        REQUIRE(sso::iequals(sso::string{ "ABC" }, std::string_view{ "abc" }));
+        REQUIRE_FALSE(sso::iequals(sso::string{ "[" }, std::string_view{ "{" }));
+        REQUIRE_EQ(sso::icompare(sso::string{ "a" }, sso::string{ "B" }), std::weak_ordering::less);
+        // '_' is between upper and lower case letters, it is compared with lower case
+        REQUIRE_EQ(sso::icompare(sso::string{ "_" }, sso::string{ "A" }), std::weak_ordering::less);
+
+        // literal or C string may be on either side
+        sso::string const header{ "content-type" };
+        char const* const c_str{ "CONTENT-TYPE" };
+        REQUIRE(sso::iequals(header, "Content-Type"));
+        REQUIRE(sso::iequals("Content-Type", header));
+        REQUIRE(sso::iequals(c_str, header));
+        REQUIRE(sso::iequals(c_str, "content-type"));
+        REQUIRE_FALSE(sso::iequals("Content-Length", header));
+        REQUIRE_EQ(sso::icompare("Accept", header), std::weak_ordering::less);
+        REQUIRE_EQ(sso::icompare(c_str, header), std::weak_ordering::equivalent);
+        REQUIRE_EQ(sso::icompare(c_str, std::string{ "Content-Length" }), std::weak_ordering::greater);
+
+        // strings with different length aren't equal even if inline buffers fold equally
+        sso::small_string<127> const zeros_62{ std::string(62, '\0') };
+        sso::small_string<127> const zeros_30{ std::string(30, '\0') };
+        REQUIRE_FALSE(sso::iequals(zeros_62, zeros_30));
+    }
+
+    TEST_CASE("case-insensitive lookup")
+    {
+        std::unordered_map<sso::string, int, sso::case_insensitive_hash, sso::case_insensitive_equal> headers;
+        headers.emplace("Content-Length", 1);
+        headers.emplace("X-Very-Long-Custom-Header-Name", 2);
+
+        REQUIRE_EQ(headers.count(sso::string{ "content-length" }), 1);
+        REQUIRE_EQ(headers.count(std::string_view{ "CONTENT-LENGTH" }), 1);
+        REQUIRE_EQ(headers.count(std::string_view{ "x-very-long-custom-header-name" }), 1);
+        REQUIRE_EQ(headers.count(std::string_view{ "content-type" }), 0);
+
+        std::map<sso::string, int, sso::case_insensitive_less> sorted{ { sso::string{ "b" }, 0 },
+                                                                     { sso::string{ "A" }, 1 },
+                                                                     { sso::string{ "C" }, 2 } };
+        REQUIRE_EQ(sorted.begin()->first, "A");
+        REQUIRE(sorted.contains(std::string_view{ "c" }));
+
+        // wide characters are hashed by folded chunks, hashes still agree with equality
+        using wide_hash = sso::basic_case_insensitive_hash<wchar_t>;
+        std::wstring_view const wide{ L"X-Very-Long-Custom-Header-Name-Which-Spans-Two-Chunks" };
+        sso::basic_string<wchar_t> const upper_wide{ L"X-VERY-LONG-CUSTOM-HEADER-NAME-WHICH-SPANS-TWO-CHUNKS" };
+        REQUIRE(sso::basic_case_insensitive_equal<wchar_t>{}(upper_wide, sso::basic_string<wchar_t>{ wide }));
+        REQUIRE_EQ(wide_hash{}(upper_wide), wide_hash{}(wide));
+    }
+
     TEST_CASE("resize")
     {
         sso::string s;
@@ -478,6 +1849,203 @@ TEST_SUITE("sso")
         REQUIRE_EQ(s, std);
     }
 
+    TEST_CASE("resize non-empty string")
+    {
+        // exact capacity, so filling past new size would be caught by sanitizer
+        using string = sso::basic_string<char, std::allocator<char>, sso::exact_growth>;
+        string s{ std::string_view{ "abc" } };
+
+        s.resize(10, 'x');
+        REQUIRE_EQ(s, "abcxxxxxxx");
+        s.resize(40, 'y');
+        REQUIRE_EQ(s, "abcxxxxxxx" + std::string(30, 'y'));
+        s.resize(2);
+        REQUIRE_EQ(s, "ab");
+    }
+
+    TEST_CASE_TEMPLATE("resize_and_overwrite", string_type, sso::string, sso::shared_string)
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("short")
+        {
+            string_type s{ std::string_view{ "abc" } };
+            s.resize_and_overwrite(20,
+                                   [](char* data, std::size_t count)
+                                   {
+                                       REQUIRE_EQ(count, 20);
+                                       REQUIRE_EQ(std::string_view(data, 3), "abc");
+                                       // written characters past returned length are discarded
+                                       std::fill_n(data + 3, 17, '!');
+                                       return 5;
+                                   });
+            REQUIRE_EQ(s, "abc!!");
+            // short string is still word comparable
+            REQUIRE_EQ(s, string_type{ std::string_view{ "abc!!" } });
+        }
+        SUBCASE("long")
+        {
+            string_type s;
+            s.resize_and_overwrite(100,
+                                   [&](char* data, std::size_t)
+                                   {
+                                       return static_cast<std::size_t>(std::ranges::copy(long_str, data).out - data);
+                                   });
+            REQUIRE_EQ(s, long_str);
+            REQUIRE_EQ(s.c_str()[s.size()], '\0');
+        }
+        SUBCASE("shrink")
+        {
+            string_type s{ long_str };
+            auto const copy{ s };
+            s.resize_and_overwrite(4, [](char*, std::size_t count) { return count; });
+            REQUIRE_EQ(s, long_str.substr(0, 4));
+            REQUIRE_EQ(copy, long_str);
+        }
+        SUBCASE("snprintf")
+        {
+            string_type s;
+            s.resize_and_overwrite(64, [](char* data, std::size_t count)
+                                   { return static_cast<std::size_t>(std::snprintf(data, count, "%d-%s", 42, "x")); });
+            REQUIRE_EQ(s, "42-x");
+        }
+    }
+
+    TEST_CASE("resize_uninitialized")
+    {
+        sso::string s{ std::string_view{ "abc" } };
+        s.resize_uninitialized(10);
+        REQUIRE_EQ(s.size(), 10);
+        REQUIRE_EQ(std::string_view(s).substr(0, 3), "abc");
+
+        s.resize_uninitialized(100);
+        std::fill_n(s.data() + 3, 97, 'z');
+        REQUIRE_EQ(s, "abc" + std::string(97, 'z'));
+        REQUIRE_EQ(s.c_str()[100], '\0');
+
+        s.resize_uninitialized(1);
+        REQUIRE_EQ(s, "a");
+    }
+
+    TEST_CASE_TEMPLATE("format", string_type, sso::string, sso::shared_string)
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("formatter")
+        {
+            string_type const s{ std::string_view{ "abc" } };
+            REQUIRE_EQ(std::format("[{}]", s), "[abc]");
+            REQUIRE_EQ(std::format("[{:>6}|{:.2}]", s, s), "[   abc|ab]");
+            REQUIRE_EQ(std::format("{}", string_type{ long_str }), long_str);
+        }
+        SUBCASE("format_to short")
+        {
+            string_type s{ std::string_view{ "id=" } };
+            auto const* const data{ s.data() };
+            REQUIRE_EQ(&sso::format_to(s, "{}:{:04x}", 42, 255), &s);
+            REQUIRE_EQ(s, "id=42:00ff");
+            // formatted in place, inline buffer
+            REQUIRE_EQ(s.data(), data);
+            // short string is still word comparable
+            REQUIRE_EQ(s, string_type{ std::string_view{ "id=42:00ff" } });
+        }
+        SUBCASE("format_to long")
+        {
+            string_type s{ std::string_view{ "prefix " } };
+            sso::format_to(s, "{} {}", long_str, 1);
+            REQUIRE_EQ(s, "prefix " + std::string(long_str) + " 1");
+            REQUIRE_EQ(s.c_str()[s.size()], '\0');
+
+            // appends into spare capacity of long string
+            auto const copy{ s };
+            sso::format_to(s, "{:*>{}}", "", 100);
+            REQUIRE_EQ(s, std::string(copy) + std::string(100, '*'));
+            REQUIRE_EQ(copy, "prefix " + std::string(long_str) + " 1");
+        }
+    }
+
+    TEST_CASE("format without allocation")
+    {
+        tracking_resource resource;
+        sso::pmr::string s{ &resource };
+        sso::format_to(s, "{}-{}", 12345, std::string_view{ "abcdef" });
+        REQUIRE_EQ(s, "12345-abcdef");
+        REQUIRE_EQ(resource.outstanding, 0);
+
+        sso::format_to(s, "{:>30}", 'x');
+        REQUIRE_EQ(s.size(), 42);
+        REQUIRE_GT(resource.outstanding, 0);
+
+        REQUIRE_EQ(sso::format("{} {}", 1, sso::string{ std::string_view{ "z" } }), "1 z");
+        REQUIRE_EQ(std::wstring_view(sso::format(L"{}!", 5)), L"5!");
+    }
+
+    TEST_CASE("format with throwing formatter")
+    {
+        int calls{ 0 };
+
+        SUBCASE("message fits")
+        {
+            sso::string s{ std::string_view{ "abc" } };
+            REQUIRE_THROWS_AS(sso::format_to(s, "{}", throwing_argument{ 10, 1, &calls }), std::runtime_error);
+            REQUIRE_EQ(s, "abc");
+            // characters after short string are zero again, so it is compared word by word correctly
+            REQUIRE_EQ(s, sso::string{ std::string_view{ "abc" } });
+        }
+        SUBCASE("message is formatted again after growth")
+        {
+            sso::string s{ std::string_view{ "abc" } };
+            REQUIRE_THROWS_AS(sso::format_to(s, "{}", throwing_argument{ 40, 2, &calls }), std::runtime_error);
+            REQUIRE_EQ(calls, 2);
+            REQUIRE_EQ(s, "abc");
+            REQUIRE_EQ(s.append("d"), "abcd");
+        }
+        SUBCASE("string is usable after exception")
+        {
+            sso::string s;
+            REQUIRE_THROWS(sso::format_to(s, "{}", throwing_argument{ 5, 1, &calls }));
+            REQUIRE(s.empty());
+            REQUIRE_EQ(sso::format_to(s, "{}", throwing_argument{ 5, 0, &calls }), "xxxxx");
+        }
+    }
+
+    TEST_CASE("constexpr")
+    {
+        using namespace sso::literals;
+
+        // whole inline buffer is usable at compile time
+        constexpr std::array<sso::string, 3> table{ "GET"_ss, "POST"_ss, "identifier_of_23_chars_"_ss };
+        static_assert(table[1] == std::string_view{ "POST" });
+        static_assert(table[2].size() == sso::string::inline_capacity());
+        static_assert(table[0] < table[1]);
+        static_assert(std::ranges::find(table, "POST"_ss) == table.begin() + 1);
+        static_assert(table[2].find("23") == 14);
+        static_assert(table[2].find_first_of("_") == 10);
+        static_assert(std::string_view{ table[0].c_str() } == "GET");
+
+        constexpr auto modified{ []
+                                 {
+                                     auto s{ "Key"_ss };
+                                     s.to_upper();
+                                     s.append(": ");
+                                     s += s;
+                                     return s;
+                                 }() };
+        static_assert(modified == std::string_view{ "KEY: KEY: " });
+        static_assert(L"wide"_ss.size() == 4);
+        static_assert(" key = value "_ss.trim().substr(6) == std::string_view{ "value" });
+        static_assert(table[2].view(11, 2) == "of");
+        static_assert(sso::small_string<63>{ std::string_view{ "abc" } }.inline_capacity() == 63);
+
+        // compile-time strings are usual short strings at runtime
+        auto s{ table[2] };
+        REQUIRE_EQ(s, table[2]);
+        REQUIRE_EQ(std::hash<sso::string>{}(s), std::hash<std::string_view>{}("identifier_of_23_chars_"));
+        s += table[1];
+        REQUIRE_EQ(s, "identifier_of_23_chars_POST");
+        REQUIRE_EQ(table[0], sso::string{ std::string_view{ "GET" } });
+    }
+
     TEST_CASE("substr")
     {
         std::string std{ "21312" };
@@ -487,5 +2055,152 @@ TEST_SUITE("sso")
         REQUIRE_EQ(std.substr(0, 0), sso.substr(0, 0));
         REQUIRE_EQ(std.substr(0, 3), sso.substr(0, 3));
         REQUIRE_EQ(std.substr(2, 50), sso.substr(2, 50));
+        REQUIRE_EQ(std.substr(2), sso.substr(2));
+        REQUIRE_THROWS_AS(static_cast<void>(sso.substr(6)), std::out_of_range);
+    }
+
+    TEST_CASE("split")
+    {
+        using parts = std::vector<std::string_view>;
+        auto const to_vector{ [](auto const& view)
+                              {
+                                  parts result;
+                                  std::ranges::copy(view, std::back_inserter(result));
+                                  return result;
+                              } };
+
+        sso::string const s{ std::string_view{ "key=value;;long value, which doesn't fit;" } };
+        static_assert(std::ranges::forward_range<decltype(sso::split(s, ';'))>);
+        static_assert(std::ranges::view<decltype(sso::split(s, ';'))>);
+        // views into temporary string would dangle
+        auto const splittable{ [](auto&& str) -> decltype(sso::split(std::forward<decltype(str)>(str), ';')) {
+            return sso::split(std::forward<decltype(str)>(str), ';');
+        } };
+        static_assert(std::is_invocable_v<decltype(splittable), sso::string&>);
+        static_assert(!std::is_invocable_v<decltype(splittable), sso::string>);
+
+        SUBCASE("by character")
+        {
+            auto const split{ to_vector(sso::split(s, ';')) };
+            REQUIRE_EQ(split, parts{ "key=value", "", "long value, which doesn't fit", "" });
+            REQUIRE_EQ(split[0].data(), s.data());
+
+            REQUIRE_EQ(to_vector(sso::split(std::string_view{}, ';')), parts{ "" });
+            REQUIRE_EQ(to_vector(sso::split(std::string_view{ "abc" }, ';')), parts{ "abc" });
+        }
+        SUBCASE("by string")
+        {
+            REQUIRE_EQ(to_vector(sso::split(s, ";;")), parts{ "key=value", "long value, which doesn't fit;" });
+            std::string const str{ "a::b:c" };
+            REQUIRE_EQ(to_vector(sso::split(str, "::")), parts{ "a", "b:c" });
+        }
+        SUBCASE("by any character")
+        {
+            REQUIRE_EQ(to_vector(sso::split_any(s, "=;,")),
+                       parts{ "key", "value", "", "long value", " which doesn't fit", "" });
+        }
+        SUBCASE("lines")
+        {
+            REQUIRE_EQ(to_vector(sso::lines("first\r\nsecond\n\nlast")), parts{ "first", "second", "", "last" });
+            REQUIRE_EQ(to_vector(sso::lines("single\n")), parts{ "single" });
+            REQUIRE(to_vector(sso::lines("")).empty());
+        }
+        SUBCASE("wide")
+        {
+            std::wstring_view const wide{ L"a b  c" };
+            REQUIRE_EQ(std::ranges::distance(sso::split(wide, L' ')), 4);
+        }
+        SUBCASE("constexpr")
+        {
+            static_assert(std::ranges::distance(sso::split(std::string_view{ "a,b,c" }, ',')) == 3);
+            static_assert(*std::ranges::next(sso::lines(std::string_view{ "a\nb" }).begin()) == "b");
+        }
+    }
+
+    TEST_CASE("join")
+    {
+        std::vector<std::string> const strings{ "first", "second", "this one is long enough" };
+        auto const joined{ sso::join(strings, ", ") };
+        REQUIRE_EQ(joined, "first, second, this one is long enough");
+        REQUIRE_EQ(joined.capacity(), joined.size());
+
+        REQUIRE(sso::join(std::vector<std::string>{}, ", ").empty());
+        REQUIRE_EQ(sso::join(sso::split(joined, ", "), "|"), "first|second|this one is long enough");
+
+        tracking_resource resource;
+        {
+            auto const pmr_joined{ sso::join<sso::pmr::string>(strings, "", &resource) };
+            REQUIRE_EQ(pmr_joined.size(), 34);
+            REQUIRE_EQ(resource.outstanding, 35);
+        }
+        REQUIRE_EQ(resource.outstanding, 0);
+
+        std::vector<std::wstring_view> const wide{ L"x", L"y" };
+        REQUIRE_EQ(std::wstring_view(sso::join<sso::basic_string<wchar_t>>(wide, L"+")), L"x+y");
+    }
+
+    TEST_CASE("substr without allocation")
+    {
+        std::string_view const long_str{ "this string is too long for small buffer" };
+
+        SUBCASE("view")
+        {
+            sso::string const s{ long_str };
+            REQUIRE_EQ(s.view(), long_str);
+            REQUIRE_EQ(s.view(5, 6), "string");
+            REQUIRE_EQ(s.view(5).data(), s.data() + 5);
+            REQUIRE_EQ(s.view(long_str.size(), 1), "");
+            REQUIRE_THROWS_AS(static_cast<void>(s.view(long_str.size() + 1)), std::out_of_range);
+        }
+        SUBCASE("rvalue substr reuses buffer")
+        {
+            tracking_resource resource;
+            sso::pmr::string s{ &resource };
+            s.append(long_str);
+            auto const* const data{ s.data() };
+            auto const outstanding{ resource.outstanding };
+
+            auto const sub{ std::move(s).substr(5, 30) };
+            REQUIRE_EQ(sub, long_str.substr(5, 30));
+            REQUIRE_EQ(sub.data(), data);
+            REQUIRE_EQ(resource.outstanding, outstanding);
+        }
+        SUBCASE("rvalue substr of shared buffer")
+        {
+            sso::shared_string const s{ long_str };
+            auto copy{ s };
+            REQUIRE_EQ(std::move(copy).substr(5), long_str.substr(5));
+            REQUIRE_EQ(s, long_str);
+        }
+        SUBCASE("remove_prefix/remove_suffix")
+        {
+            sso::string s{ long_str };
+            auto const* const data{ s.data() };
+            s.remove_prefix(5).remove_suffix(13);
+            REQUIRE_EQ(s, long_str.substr(5, long_str.size() - 5 - 13));
+            REQUIRE_EQ(s.data(), data);
+
+            s.remove_suffix(s.size());
+            REQUIRE(s.empty());
+            REQUIRE_EQ(std::strlen(s.c_str()), 0);
+
+            sso::string small{ "prefix:name" };
+            small.remove_prefix(7);
+            REQUIRE_EQ(small, "name");
+            REQUIRE_EQ(small.size(), 4);
+        }
+        SUBCASE("trim")
+        {
+            sso::string s{ " \t value with spaces\r\n" };
+            REQUIRE_EQ(s.trim(), "value with spaces");
+            REQUIRE_EQ(s.trim("vs"), "alue with space");
+
+            sso::string blank{ " \n " };
+            REQUIRE(blank.trim().empty());
+
+            std::wstring_view const wide{ L"  wide string, which is long enough to be on heap  " };
+            sso::basic_string<wchar_t> w{ wide };
+            REQUIRE_EQ(std::wstring_view(w.trim()), wide.substr(2, wide.size() - 4));
+        }
     }
 }